@@ -0,0 +1,145 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/budget.h"
+#include "../include/clique.h"
+#include "../include/context.h"
+#include "../include/dfs_engine.h"
+#include "../include/dsatur_engine.h"
+#include "../include/graph.h"
+#include "../include/heuristics.h"
+#include "../include/ordering.h"
+#include "../include/parallel_search.h"
+#include "../include/search_strategy.h"
+#include "../include/solution.h"
+
+// benchmark harness: solves a fixed set of DIMACS instances and seeded random graphs, and reports for each one the
+// colors found, the nodes explored and the wall time, so runs of two versions can be compared line by line. Every
+// graph goes through the dynamic_dim types, whatever its size
+
+#ifndef GC_INPUT_DIR
+#define GC_INPUT_DIR "../inputs"
+#endif
+
+// DIMACS instances of inputs/, looked up in the input directory: the missing ones (e.g. in another directory) are
+// reported and skipped
+const std::vector<std::string> instances = {
+  "myciel3.col", "myciel4.col", "myciel5.col",
+  "queen5_5.col", "queen6_6.col", "queen7_7.col", "queen8_8.col",
+};
+
+// random G(nodes, density) graphs, fixed by their seed
+struct random_instance {
+  unsigned int nodes;
+  double density;
+  uint64_t seed;
+};
+
+const std::vector<random_instance> random_instances = {
+  {50, 0.9, 1}, {70, 0.5, 2}, {100, 0.2, 3}, {2000, 0.002, 4},
+};
+
+struct bench_options {
+  std::string input_dir = GC_INPUT_DIR;
+  std::string engine = "dfs";
+  unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+  // seconds given to each instance, 0 for no limit
+  double time_limit = 0;
+};
+
+// silences std::cout while alive: the engines print every improving solution
+struct quiet_cout {
+  std::streambuf* saved = std::cout.rdbuf(nullptr);
+  ~quiet_cout() { std::cout.rdbuf(saved); }
+};
+
+// DSATUR warm start then exact search, prints one line of results. Searches cut by the time limit are marked with
+// a "*" after their colors
+void run(const std::string& name, const graph<dynamic_dim>& g, const bench_options& opt) {
+  const auto start = std::chrono::steady_clock::now();
+
+  search_budget budget(opt.time_limit);
+  const node_selector<dynamic_dim> selector(g, selection::dsatur);
+  context<dynamic_dim> ctx(g, &selector);
+  ctx.budget = &budget;
+  ctx.colors_lb = greedy_clique(g).size();
+
+  const solution<dynamic_dim> incumbent(ctx, dsatur_coloring(g));
+  ctx.colors_ub = incumbent.tot_colors;
+
+  unsigned long int explored = 0;
+  unsigned int colors = 0;
+  {
+    quiet_cout quiet;
+    if (opt.engine == "dfs") {
+      dfs_engine<dynamic_dim> engine(ctx);
+      engine.seed(incumbent.coloring());
+      engine.run();
+      explored = engine.tot_nodes_explored;
+      colors = colors_used<dynamic_dim>(engine.best);
+    } else if (opt.engine == "dsatur") {
+      dsatur_engine<dynamic_dim> engine(ctx);
+      engine.seed(incumbent.coloring());
+      engine.run();
+      explored = engine.tot_nodes_explored;
+      colors = colors_used<dynamic_dim>(engine.best);
+    } else if (opt.engine == "parallel") {
+      parallel_search<dynamic_dim> search(ctx, opt.threads);
+      colors = search.run(&incumbent).tot_colors;
+      explored = search.tot_solutions_generated;
+    } else {
+      colors = sequential_search(ctx, &incumbent, parse_strategy(opt.engine), 1ul << 30, explored).tot_colors;
+    }
+  }
+
+  const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::printf("%-20s %8u %10lu %4u %5u%c %14lu %12.1f\n", name.c_str(), g.size(), g.edges(), ctx.colors_lb, colors,
+              budget.stopped() ? '*' : ' ', explored, ms);
+  std::fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+
+  bench_options opt;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+      opt.engine = argv[++i];
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      opt.threads = std::stoul(argv[++i]);
+    } else if (std::strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) {
+      opt.time_limit = std::stod(argv[++i]);
+    } else if (argv[i][0] == '-') {
+      std::cerr << "Usage: " << argv[0] << " [--engine dfs|dsatur|parallel|best-first|lds|hybrid] [--threads n]"
+                << " [--time-limit seconds] [input directory]\n";
+      return 1;
+    } else {
+      opt.input_dir = argv[i];
+    }
+  }
+
+  try {
+    std::printf("%-20s %8s %10s %4s %6s %14s %12s\n", "instance", "nodes", "edges", "lb", "colors", "explored",
+                "time_ms");
+    for (const auto& name : instances) {
+      const std::string path = opt.input_dir + "/" + name;
+      if (!std::filesystem::exists(path)) {
+        std::printf("%-20s missing\n", name.c_str());
+        continue;
+      }
+      run(name, graph<dynamic_dim>(path), opt);
+    }
+    for (const auto& r : random_instances) {
+      const std::string name = "G(" + std::to_string(r.nodes) + "," + std::to_string(r.density).substr(0, 5) + ")";
+      run(name, graph<dynamic_dim>(r.density, r.nodes, r.seed), opt);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ordering.h"
+
+// batch mode: many (mostly small) graphs solved in one process. A fixed pool of threads takes the graphs one after
+// the other, each one with a budget of its own, and hands them to a color function that runs the search (with a
+// context of its own); the threads, the process and its setup are paid once for the whole batch, while the engine
+// and its buffers are built again for every graph. Every graph goes through the dynamic_dim types
+//
+// color(g, budget, colors_lb, explored) returns a complete coloring of g (colors from 1) found within budget, knowing
+// that g needs at least colors_lb colors, and adds the nodes it explored to explored. It is called from several
+// threads at once
+
+struct batch_options {
+    unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    renumbering renumber = renumbering::none;
+
+    // budget of each graph, 0 for none
+    double time_limit = 0;
+    unsigned long int node_limit = 0;
+
+    // write the colorings too, not only their number of colors
+    bool colorings = true;
+};
+
+// outcome of one graph of a batch
+struct batch_result {
+    std::string file;
+    unsigned int nodes = 0;
+    unsigned long int edges = 0;
+
+    unsigned int colors = 0;
+    unsigned int colors_lb = 0;
+    // false if the budget ran out first: colors is then only an upper bound
+    bool optimal = false;
+
+    unsigned long int explored = 0;
+    double time_ms = 0;
+
+    std::vector<unsigned int> coloring;
+
+    // set if the graph could not be solved (e.g. unreadable file), the other fields are then meaningless
+    std::string error;
+};
+
+// input files of a batch: the .col and .gcb files of a directory, in name order, or the paths listed in a text file,
+// one per line (blank lines and lines starting with # are skipped)
+std::vector<std::string> batch_inputs(const std::string& path);
+
+// solves a single graph with color, errors are reported in the result
+template<typename Color>
+batch_result solve_one(const std::string& file, const batch_options& opt, Color&& color);
+
+// solves all the files with color on opt.threads threads and calls sink(result) for each one as soon as it is done
+// (in completion order, one call at a time). Files not started yet are skipped once SIGINT/SIGTERM is caught
+template<typename Color, typename Sink>
+void solve_batch(const std::vector<std::string>& files, const batch_options& opt, Color&& color, Sink&& sink);
+
+// writes a result as a single line of JSON
+void write_json_line(std::ostream& out, const batch_result& r, bool with_coloring);
+
+#include "../src/batch.tpp"
+
+#endif //BATCH_H
@@ -0,0 +1,27 @@
+#ifndef BITS_H
+#define BITS_H
+
+#include <bit>
+#include <cstdint>
+
+// helpers for sets packed into arrays of 64-bit words: element i lives in bit (i % 64) of word (i / 64)
+
+// number of words needed to store a set over [0, n)
+constexpr unsigned int bit_words(unsigned int n) { return (n + 63) / 64; }
+
+bool test_bit(const uint64_t* bits, unsigned int i);
+
+void set_bit(uint64_t* bits, unsigned int i);
+
+void clear_bit(uint64_t* bits, unsigned int i);
+
+// number of elements in the set
+unsigned int count_bits(const uint64_t* bits, unsigned int words);
+
+// calls f(i) for every element i of the set, in increasing order
+template<typename F>
+void for_each_bit(const uint64_t* bits, unsigned int words, F&& f);
+
+#include "../src/bits.tpp"
+
+#endif //BITS_H
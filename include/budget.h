@@ -0,0 +1,70 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include <atomic>
+#include <chrono>
+
+// why a search stopped before exhausting its tree
+enum class stop_reason {
+    none,
+    time_limit,
+    node_limit,
+    signal      // SIGINT or SIGTERM
+};
+
+// name of a stop reason, as printed in the results
+const char* stop_reason_name(stop_reason reason);
+
+// wall clock and node budget shared by every search of one solve. Engines charge it for each node they explore and
+// unwind once it is spent, keeping their incumbent. The clock, the node total and the signal flag are only looked at
+// every check_every nodes of each thread, so charging a node costs a relaxed load
+struct search_budget {
+
+    // time_limit in seconds and node_limit in explored nodes, 0 for no limit
+    explicit search_budget(double time_limit = 0, unsigned long int node_limit = 0);
+
+    const double time_limit;
+    const unsigned long int node_limit;
+
+    // counts one node explored by the calling thread. local is the thread's own count of nodes not reported yet,
+    // starting at 0. Returns true once the search must stop
+    bool charge(unsigned long int& local);
+
+    // true once the budget is spent (or a signal was caught)
+    bool stopped() const;
+
+    // first reason the budget ran out, none if it did not
+    stop_reason reason() const;
+
+    // seconds since the budget was created
+    double elapsed() const;
+
+    // seconds left before the time limit (0 once it has passed), infinity if there is none
+    double remaining() const;
+
+    // makes SIGINT and SIGTERM stop every running search instead of killing the process. A second signal kills it
+    static void catch_signals();
+
+    // true once SIGINT or SIGTERM was caught
+    static bool signalled();
+
+private:
+
+    const unsigned long int check_every;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::atomic<unsigned long int> nodes{0};
+    std::atomic<stop_reason> why{stop_reason::none};
+
+    // set by the signal handler
+    static inline std::atomic<bool> interrupted{false};
+
+    static void on_signal(int sig);
+
+    void stop(stop_reason reason);
+};
+
+#include "../src/budget.tpp"
+
+#endif //BUDGET_H
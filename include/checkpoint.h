@@ -0,0 +1,59 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// saved state of a depth-first search, enough to continue it in another process. The open frontier of a DFS is
+// implied by the branching path: the siblings left to try at each depth are the colors above the one on the path,
+// so the file holds the path and the incumbent, not the open nodes
+struct checkpoint {
+
+    // graph the search runs on, checked when resuming
+    unsigned int nodes = 0;
+    unsigned long int edges = 0;
+
+    // size of the root clique colored before the path
+    unsigned int root_clique = 0;
+
+    // colors of best, or the initial bound if there is no incumbent
+    unsigned int colors_ub = 0;
+
+    // nodes explored before the checkpoint
+    unsigned long int explored = 0;
+
+    // true if the tree was exhausted: best is optimal and there is nothing left to search
+    bool done = false;
+
+    // incumbent coloring, empty if none
+    std::vector<unsigned int> best;
+
+    // (node, color) branched on at each depth, from the root
+    std::vector<std::pair<unsigned int, unsigned int>> path;
+
+    // writes the checkpoint to a temporary file renamed over file_path, so a crash never leaves a partial file
+    void save(const std::string& file_path) const;
+
+    static checkpoint load(const std::string& file_path);
+};
+
+// fixed-size head of a checkpoint file, followed by best (nodes uint32 if has_best) and path (2 uint32 per depth)
+struct checkpoint_header {
+    char magic[8];          // "GCOLCKP1"
+    uint32_t nodes;
+    uint32_t root_clique;
+    uint64_t edges;
+    uint64_t explored;
+    uint32_t colors_ub;
+    uint32_t depth;
+    uint32_t has_best;
+    uint32_t done;
+};
+
+constexpr char checkpoint_magic[8] = {'G', 'C', 'O', 'L', 'C', 'K', 'P', '1'};
+
+#include "../src/checkpoint.tpp"
+
+#endif //CHECKPOINT_H
@@ -0,0 +1,16 @@
+#ifndef CLIQUE_H
+#define CLIQUE_H
+
+#include <vector>
+
+#include "graph.h"
+
+// greedy maximal clique: starting from each of the max_starts highest degree nodes, the clique is repeatedly extended
+// with the candidate having most neighbours among the remaining candidates. Returns the largest clique found, whose
+// size is a lower bound on the number of colors of any valid coloring.
+template<unsigned int dim>
+std::vector<unsigned int> greedy_clique(const graph<dim>& g, unsigned int max_starts = 256);
+
+#include "../src/clique.tpp"
+
+#endif //CLIQUE_H
@@ -0,0 +1,90 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "budget.h"
+#include "graph.h"
+#include "ordering.h"
+#include "telemetry.h"
+
+// symmetries removed from the search tree, on top of the new color being capped at tot_colors + 1
+enum class symmetry {
+    none,
+    clique,     // the nodes of a clique get colors 1..k at the root
+    dominance   // clique, plus a node dominated by a colored node only takes its color
+};
+
+// parses a symmetry breaking level as given on the command line: none, clique or dominance
+symmetry parse_symmetry(const std::string& name);
+
+// state shared by all the nodes of one search: the graph, the bounds and the branching policy. Each solve owns its
+// context, so independent solves (of graphs of the same dim, too) can run side by side in one process
+template<unsigned int dim>
+struct context {
+
+    explicit context(const graph<dim>& g, const node_selector<dim>* selector = nullptr);
+
+    const graph<dim>& g;
+
+    // most colors a search uses: an optimal coloring never needs more than max_degree + 1 colors, which also bounds
+    // the size of the forbidden color sets of dynamic_dim graphs
+    const unsigned int max_colors;
+
+    // policy choosing the node to branch on, nodes are taken in input order if null
+    const node_selector<dim>* selector;
+
+    // upper bound on number of colors to use, shared by all the threads of a parallel search
+    std::atomic<unsigned int> colors_ub;
+
+    // lower bound on number of colors of any valid coloring of g (e.g. size of a clique)
+    unsigned int colors_lb = 0;
+
+    // nodes colored 1, 2, ... (in this order) at the root of every search. The nodes of a clique all have different
+    // colors, so up to a permutation of the colors they can be given the first ones
+    std::vector<unsigned int> root_clique;
+
+    // dominators[v]: nodes not adjacent to v whose neighbours include all the neighbours of v. Once one of them is
+    // colored, giving v the same color loses no coloring (none of the neighbours of v can have it), so it is the only
+    // branch searched for v. Swapping two such nodes is a symmetry of the graph when their neighbourhoods are equal.
+    // Empty if the pruning is off
+    std::vector<std::vector<unsigned int>> dominators;
+
+    // fills root_clique and dominators as required by level
+    void break_symmetries(symmetry level);
+
+    // color that node v has to take because a dominator of v is colored, 0 if none. color(i) is the color of node i
+    template<typename Color>
+    unsigned int forced_color(unsigned int v, Color&& color) const;
+
+    // number of 64-bit words of a forbidden color set (colors are in [1, max_colors])
+    unsigned int color_words() const;
+
+    // live counters updated by the engines, none if null
+    search_stats* stats = nullptr;
+
+    // time and node budget of the search, unlimited if null
+    search_budget* budget = nullptr;
+
+    // stream the engines print every improved solution to, nowhere if null
+    std::ostream* log = &std::cout;
+
+    // lowers colors_ub to ub if it is smaller, returns true if it did
+    bool improve_ub(unsigned int ub);
+
+    // node to branch on after last was colored (last == g.size() at the root), g.size() if every node is colored.
+    // color(i) != 0 tells whether node i is colored, saturation(i) is its number of forbidden colors
+    template<typename Color, typename Saturation>
+    unsigned int next_node(unsigned int last, Color&& color, Saturation&& saturation) const;
+
+    // same as next_node() for a single_word_dim graph, the uncolored nodes given as the bitset open
+    template<typename Saturation>
+    unsigned int next_open_node(unsigned int last, uint64_t open, Saturation&& saturation) const;
+};
+
+#include "../src/context.tpp"
+
+#endif //CONTEXT_H
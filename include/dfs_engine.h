@@ -0,0 +1,94 @@
+#ifndef DFS_ENGINE_H
+#define DFS_ENGINE_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "checkpoint.h"
+#include "context.h"
+#include "graph.h"
+#include "inplace_search.h"
+
+// depth-first branch and bound working on a single mutable coloring. Coloring a node records the forbidden color
+// bits it sets on a trail, so backtracking undoes exactly those changes: the search performs no allocation and no
+// O(dim) copy per explored node.
+template<unsigned int dim>
+struct dfs_engine : inplace_search<dfs_engine<dim>, dim> {
+
+    using base = inplace_search<dfs_engine<dim>, dim>;
+    using base::ctx, base::g, base::best, base::tot_nodes_explored;
+
+    // ctx.colors_ub is lowered as better colorings are found, the search stops as soon as it reaches ctx.colors_lb.
+    // Nodes are picked by ctx.selector
+    explicit dfs_engine(context<dim>& ctx);
+
+    // explores the search tree until it is exhausted or ctx.colors_ub reaches ctx.colors_lb, keeping the best coloring in
+    // best. The engine is only meant to be run once
+    void run();
+
+    // if not empty, the search is saved to this file every checkpoint_period seconds and when it ends or runs out of
+    // budget, so that it can be resumed in another process
+    std::string checkpoint_path;
+    double checkpoint_period = 60;
+
+    // continues the search saved in cp instead of starting from the root. The graph, the context (symmetries
+    // included) and the node selection must be the same as when it was saved. Call after seed(), before run()
+    void resume(const checkpoint& cp);
+
+private:
+
+    friend base;
+    using typename base::frame;
+    using base::color, base::frames, base::tot_colors, base::has_best;
+
+    // forbidden colors of each node, bit c of node i is set if some neighbour of i has color c
+    storage_t<uint64_t, dim * bit_words(dim + 1)> forbidden;
+
+    // nodes whose forbidden set was modified, in order, so the modifications can be undone
+    std::vector<unsigned int> trail;
+
+    // trail_marks[d]: size of the trail before the node of depth d was colored
+    std::vector<std::size_t> trail_marks;
+
+    // uncolored nodes of a single_word_dim graph, so that picking the next node does not scan the coloring
+    uint64_t open = 0;
+
+    // path of a resumed search, replayed when run() starts
+    std::vector<std::pair<unsigned int, unsigned int>> replay;
+
+    // the resumed search had already ended
+    bool finished = false;
+
+    // next periodic checkpoint
+    std::chrono::steady_clock::time_point next_checkpoint;
+
+    // writes a checkpoint with the first depth frames as branching path
+    void save_checkpoint(unsigned int depth, bool done) const;
+
+    unsigned int color_words() const;
+
+    uint64_t* forbidden_colors(unsigned int i);
+
+    // node to branch on after last was colored
+    unsigned int select_next(unsigned int last);
+
+    // gives color c to node v and forbids it on the uncolored neighbours of v, the changes are recorded at depth
+    void assign(unsigned int v, unsigned int c, unsigned int depth);
+
+    // reverts the assign() of frame f, made at depth
+    void undo(const frame& f, unsigned int depth);
+
+    // smallest color greater than after that node v can take without exceeding max_color, 0 if there is none
+    unsigned int next_color(unsigned int v, unsigned int after, unsigned int max_color);
+
+    // checkpoints every checkpoint_period seconds, and when the budget stops the search
+    void visited(unsigned int depth);
+    void out_of_budget(unsigned int depth);
+
+    std::chrono::steady_clock::duration checkpoint_interval() const;
+};
+
+#include "../src/dfs_engine.tpp"
+
+#endif //DFS_ENGINE_H
@@ -0,0 +1,56 @@
+#ifndef DIMACS_H
+#define DIMACS_H
+
+#include <cstddef>
+#include <string>
+
+// read-only memory mapping of a whole file
+struct mapped_file {
+
+    explicit mapped_file(const std::string& file_path);
+
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+// zero-copy reader of DIMACS graph files: the file is memory mapped and scanned in place, with no per-line
+// allocation. The constructor parses everything up to the "p edge <nodes> <edges>" line ("p col" is accepted too)
+struct dimacs_reader {
+
+    explicit dimacs_reader(const std::string& file_path);
+
+    unsigned int nodes = 0;
+    unsigned long int edges = 0;
+
+    // calls f(u, v) for every "e u v" line, with 0-based nodes. Throws if a node is out of [1, nodes]
+    template<typename F>
+    void for_each_edge(F&& f);
+
+private:
+
+    std::string file_path;
+    mapped_file file;
+
+    // position of the first line after the "p" line
+    const char* body = nullptr;
+
+    const char* end() const;
+
+    // parses an unsigned integer at p, skipping blanks, and moves p past it. Throws if there is none
+    unsigned long int parse_uint(const char*& p) const;
+
+    // moves p to the start of the next line
+    const char* next_line(const char* p) const;
+};
+
+// reads the number of nodes from the "p edge" line of a DIMACS file
+unsigned int dimacs_nodes(const std::string& file_path);
+
+#include "../src/dimacs.tpp"
+
+#endif //DIMACS_H
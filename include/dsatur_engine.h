@@ -0,0 +1,80 @@
+#ifndef DSATUR_ENGINE_H
+#define DSATUR_ENGINE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "context.h"
+#include "graph.h"
+#include "inplace_search.h"
+
+// exact DSATUR branch and bound in the style of PASS (San Segundo, 2012). Each color class is kept as the bitset of
+// the nodes adjacent to it, so coloring a node updates the saturations with word operations over its row, and
+// backtracking clears the same bits again. A sparse() graph has no rows: its nodes join the classes one neighbour at
+// a time, recorded on a trail. The node to branch on has the highest saturation, ties broken by the PASS rule then by
+// degree among the uncolored nodes
+template<unsigned int dim>
+struct dsatur_engine : inplace_search<dsatur_engine<dim>, dim> {
+
+    using base = inplace_search<dsatur_engine<dim>, dim>;
+    using base::ctx, base::g, base::best, base::tot_nodes_explored;
+
+    // ctx.colors_ub is lowered as better colorings are found, the search stops as soon as it reaches ctx.colors_lb.
+    // ctx.selector is not used. The root is a clique colored 1, 2, ...: ctx.root_clique, or a greedy clique if empty
+    explicit dsatur_engine(context<dim>& ctx);
+
+    // explores the search tree until it is exhausted, ctx.colors_ub reaches ctx.colors_lb or ctx.budget is spent,
+    // keeping the best coloring in best. The engine is only meant to be run once
+    void run();
+
+private:
+
+    friend base;
+    using typename base::frame;
+    using base::color, base::frames, base::tot_colors, base::has_best;
+
+    // words of a row, a constant for a fixed dim
+    unsigned int words() const;
+
+    // uncolored nodes
+    std::vector<uint64_t> open;
+
+    // adjacent[c * words ...]: nodes with a neighbour of color c, so saturation[v] of an uncolored node v is the number
+    // of classes holding v. The bits of the colored nodes are not read
+    std::vector<uint64_t> adjacent;
+    std::vector<unsigned int> saturation;
+
+    // every node, the open set given to row_saturate()
+    std::vector<uint64_t> every;
+
+    // fresh[d * words ...]: nodes added to their class by the node colored at depth d, cleared again by undo()
+    std::vector<uint64_t> fresh;
+
+    // sparse graph, instead of fresh: nodes added to their class, in order, trail_marks[d] of them before the node of
+    // depth d was colored
+    std::vector<unsigned int> trail;
+    std::vector<std::size_t> trail_marks;
+
+    // uncolored nodes of highest saturation, while selecting
+    std::vector<uint64_t> ties;
+
+    // node to branch on: highest saturation, then the one sharing most of its free colors with the tied neighbours
+    // (PASS), then highest degree among the uncolored nodes. The node colored last does not matter
+    unsigned int select_next(unsigned int last);
+
+    // gives color c to node v, the changes to the classes are recorded at depth
+    void assign(unsigned int v, unsigned int c, unsigned int depth);
+
+    // reverts the assign() of frame f, made at depth
+    void undo(const frame& f, unsigned int depth);
+
+    // true if no neighbour of v has color c
+    bool is_free(unsigned int v, unsigned int c) const;
+
+    // smallest color greater than after that node v can take without exceeding max_color, 0 if there is none
+    unsigned int next_color(unsigned int v, unsigned int after, unsigned int max_color) const;
+};
+
+#include "../src/dsatur_engine.tpp"
+
+#endif //DSATUR_ENGINE_H
@@ -1,34 +1,168 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <random>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "bits.h"
+#include "dimacs.h"
+
+// value of dim selecting a graph/solution whose number of nodes is only known at runtime (e.g. from the file header)
+constexpr unsigned int dynamic_dim = 0;
+
+// fixed-size storage for the dim template, heap storage sized at runtime for dynamic_dim
+template<typename T, unsigned int dim>
+using storage_t = std::conditional_t<dim == dynamic_dim, std::vector<T>, std::array<T, dim>>;
+
+// fixed sizes whose adjacency rows are a single 64-bit word: their node sets fit in a register, which the search
+// kernels use in place of loops over the nodes
+template<unsigned int dim>
+constexpr bool single_word_dim = dim != dynamic_dim && dim <= 64;
+
+// zero-initialized storage for n elements (n must be dim unless dim is dynamic_dim)
+template<typename T, unsigned int dim>
+storage_t<T, dim> make_storage(unsigned int n);
+
+// header of the binary graph format. It is followed by the packed adjacency rows, nodes * words 64-bit words in
+// native byte order, which are loaded with a single read: no parsing, no symmetric entries or duplicates to handle.
+// A graph stored as adjacency lists has words == 0 and is followed by its nodes + 1 offsets (64-bit) and its
+// 2 * edges neighbours (32-bit) instead
+struct binary_header {
+    char magic[8];          // "GCOLBIN1"
+    uint32_t nodes;
+    uint32_t words;         // words per row, (nodes + 63) / 64, or 0 for adjacency lists
+    uint64_t edges;
+};
+
+constexpr char binary_magic[8] = {'G', 'C', 'O', 'L', 'B', 'I', 'N', '1'};
+
+// size in bytes of the binary file written for header, 0 if words is neither 0 nor bit_words(nodes)
+uint64_t binary_file_bytes(const binary_header& header);
+
+// a dynamic_dim graph with at least sparse_min_nodes nodes and a density (from the file header) below
+// sparse_max_density is stored as sorted adjacency lists (CSR) instead of a bit matrix: n^2 / 8 bytes would not fit
+// for 10^5-10^6 nodes, while the lists only take 8 bytes per edge
+constexpr unsigned int sparse_min_nodes = 1024;
+constexpr double sparse_max_density = 0.01;
+
+// value number counter of the random stream stream (splitmix64 over the pair): streams can be drawn in any order
+// and from any thread, and always give the same values for the same seed
+uint64_t stream_random(uint64_t stream, uint64_t counter);
+
+// true if the file starts with the magic of the binary graph format
+bool is_binary_graph(const std::string& file_path);
+
+// number of nodes of a graph file, either DIMACS or binary. Throws if the header of a binary file does not match
+// its size
+unsigned int graph_nodes(const std::string& file_path);
 
 template<unsigned int dim>
 struct graph {
 
+    // loads a DIMACS file, or a file written by save()
     explicit graph(const std::string& file_path);
 
-    explicit graph(double density);
+    // random graph, nodes must match dim unless dim is dynamic_dim. Seeded from std::random_device
+    explicit graph(double density, unsigned int nodes = dim);
+
+    // random graph G(nodes, density), identical for identical arguments. Each row samples its edges by geometric
+    // skips over its own random stream, in O(degree), and rows are spread over threads. A sparse dynamic_dim graph
+    // gets adjacency lists, as when loaded from a file
+    graph(double density, unsigned int nodes, uint64_t seed,
+          unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u));
+
+    // subgraph of g induced by nodes: node i of the subgraph is node nodes[i] of g, stored as adjacency lists if g
+    // is. For a fixed dim nodes must hold dim nodes, i.e. renumber the nodes of g
+    template<unsigned int other>
+    graph(const graph<other>& g, const std::vector<unsigned int>& nodes);
+
+    // number of nodes
+    unsigned int size() const;
+
+    // number of 64-bit words needed to store a row of the adjacency matrix
+    unsigned int words() const;
 
-    // incident matrix
-    std::array<std::array<bool, dim>, dim> m;
+    // incident matrix, bit-packed: bit (j % 64) of word (j / 64) in row i is set if i and j are adjacent. Empty if
+    // the graph is sparse()
+    storage_t<uint64_t, dim * bit_words(dim)> m;
+
+    // true if the graph is stored as adjacency lists, never for a fixed dim
+    bool sparse() const;
 
     bool operator()(unsigned int i, unsigned int j) const;
 
+    // returns the packed adjacency row of node i, 64 neighbours per word. Only for a graph that is not sparse()
+    const uint64_t* row(unsigned int i) const;
+
+    // calls f(j) for every neighbour j of node i, in increasing order
+    template<typename F>
+    void for_each_neighbour(unsigned int i, F&& f) const;
+
+    // number of neighbours of node i
+    unsigned int degree(unsigned int i) const;
+
+    // largest degree of a node, 0 for an empty graph
+    unsigned int max_degree() const;
+
+    // number of neighbours of node i that belong to the node set encoded by mask (word-wide AND + popcount)
+    unsigned int count_neighbours_in(unsigned int i, const uint64_t* mask) const;
+
+    // removes from the node set encoded by set (words() words) the nodes that are not neighbours of node i
+    void intersect_neighbours(unsigned int i, uint64_t* set) const;
+
+    // adds the undirected edge (i, j). O(edges) on a sparse graph
+    void add_edge(unsigned int i, unsigned int j);
+
+    // removes the undirected edge (i, j) if present. O(edges) on a sparse graph
+    void remove_edge(unsigned int i, unsigned int j);
+
+    // number of edges
+    unsigned long int edges() const;
+
+    // writes the graph in the binary format
+    void save(const std::string& file_path) const;
+
     friend std::ostream& operator<<(std::ostream& os, const graph<dim>& g) {
-        for (unsigned int i = 0; i < dim; ++i) {
-            for (unsigned int j = 0; j < dim; ++j) {
-                os << g.m[i][j] << "  ";
+        for (unsigned int i = 0; i < g.size(); ++i) {
+            for (unsigned int j = 0; j < g.size(); ++j) {
+                os << g(i, j) << "  ";
             }
             os << "\n";
         }
         return os;
     }
+
+private:
+
+    // runtime size, only meaningful for dynamic_dim
+    unsigned int n = dim;
+    unsigned int w = bit_words(dim);
+
+    // adjacency lists of a sparse graph: the neighbours of node i are adj[offsets[i]] .. adj[offsets[i + 1] - 1]
+    bool csr = false;
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned int> adj;
+
+    // sizes the matrix for the given number of nodes (dynamic_dim), or checks it against dim. With lists set, the
+    // graph is sparse and starts with empty adjacency lists instead
+    void resize(unsigned int nodes, bool lists = false);
+
+    // fills the adjacency lists from the edges of reader, in two passes over the mapped file
+    void load_lists(dimacs_reader& reader, const std::string& file_path);
+
+    // loads a file written by save(), throwing if it is corrupted: a size that does not match the header, a dense
+    // row with a bit set past the last node, on the diagonal or without its mirror, or a neighbour out of range
+    void load_binary(const std::string& file_path);
 };
 
 #include "../src/graph.tpp"
@@ -0,0 +1,47 @@
+#ifndef HEURISTICS_H
+#define HEURISTICS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "budget.h"
+#include "graph.h"
+
+// heuristic colorings, used to seed the exact search with a good upper bound. All of them return a complete valid
+// coloring with colors in [1, k]
+
+// first-fit coloring: nodes are given the smallest color not used by their neighbours, in the given order
+template<unsigned int dim>
+storage_t<unsigned int, dim> greedy_coloring(const graph<dim>& g, const std::vector<unsigned int>& order);
+
+// DSATUR greedy: the next node is the one with most distinct neighbour colors, ties broken by degree
+template<unsigned int dim>
+storage_t<unsigned int, dim> dsatur_coloring(const graph<dim>& g);
+
+// tabu search (TabuCol) for a coloring with fewer colors than initial: starting from initial, tries k = colors - 1,
+// colors - 2, ... down to min_colors, until time_limit_s seconds have passed or budget (if any) is stopped. Returns
+// the best coloring found
+template<unsigned int dim>
+storage_t<unsigned int, dim> tabucol(const graph<dim>& g, const storage_t<unsigned int, dim>& initial,
+                                     unsigned int min_colors, double time_limit_s,
+                                     const search_budget* budget = nullptr, uint64_t seed = 1);
+
+// number of colors used by a coloring
+template<unsigned int dim>
+unsigned int colors_used(const storage_t<unsigned int, dim>& coloring);
+
+// heuristic used to warm start the exact search
+enum class warm_start {
+    none,
+    greedy,     // first-fit in decreasing degree order
+    dsatur,     // DSATUR greedy
+    tabucol     // DSATUR greedy improved by a time-boxed tabu search
+};
+
+// parses a heuristic name as given on the command line: none, greedy, dsatur or tabucol
+warm_start parse_warm_start(const std::string& name);
+
+#include "../src/heuristics.tpp"
+
+#endif //HEURISTICS_H
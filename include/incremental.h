@@ -0,0 +1,107 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+
+// coloring of a graph that changes by a few edges at a time. Edges are added and removed through the structure,
+// then repair() fixes the coloring around the changed edges only: the previous number of colors is the target, so
+// a re-solve costs about the neighbourhood of the changes instead of a full search
+template<unsigned int dim>
+struct incremental_coloring {
+
+    // g with a valid coloring of it (colors in [1, k]) and a clique of g, whose size bounds the colors from below
+    incremental_coloring(graph<dim> g, const storage_t<unsigned int, dim>& coloring,
+                         std::vector<unsigned int> clique);
+
+    // the graph, only changed through add_edge() and remove_edge()
+    graph<dim> g;
+
+    // colors in [1, colors] of the nodes of g, valid after each repair()
+    storage_t<unsigned int, dim> coloring;
+    unsigned int colors;
+
+    // clique of g, its size is the lower bound. Recomputed by repair() once a removed edge breaks it
+    std::vector<unsigned int> clique;
+
+    // nodes recolored by the last repair()
+    unsigned int recolored = 0;
+
+    // nodes around the changes that the local search may recolor, the rest of the coloring is kept: the nodes up
+    // to region_radius hops away from a conflict, twice as far after each failed search, at most region_cap nodes
+    unsigned int region_radius = 2;
+    unsigned int region_cap = 4096;
+
+    // adds (i, j) to g, the coloring may conflict on it until repair(). Does nothing if the edge exists
+    void add_edge(unsigned int i, unsigned int j);
+
+    // removes (i, j) from g, repair() then tries to drop a color
+    void remove_edge(unsigned int i, unsigned int j);
+
+    // repairs the coloring after the changes since the last call, searching at most time_limit_s seconds, and
+    // returns its number of colors. First the conflicting nodes take a free color, then a tabu search over the
+    // region around them looks for a coloring with the previous colors, and only if it finds none the nodes left in
+    // conflict take new colors. Last the highest color class is emptied into the others while it can be
+    unsigned int repair(double time_limit_s = 0.1);
+
+    // size of the clique
+    unsigned int lower_bound() const;
+
+    // true if the coloring matches the lower bound
+    bool optimal() const;
+
+private:
+
+    // ends of the edges added since the last repair() whose colors were equal, then the nodes left in conflict
+    std::vector<unsigned int> conflicted;
+
+    bool clique_broken = false;
+    bool removed = false;
+
+    std::mt19937_64 gen{1};
+
+    // position of a node in the region of the local search, none outside of it. Kept at none between repairs
+    static constexpr unsigned int none = ~0u;
+    std::vector<unsigned int> slot;
+
+    // color of the nodes recolored by the running repair() before it started (0: not recolored), and their list
+    std::vector<unsigned int> original;
+    std::vector<unsigned int> touched;
+
+    // recolors v, remembering its color before the repair
+    void set_color(unsigned int v, unsigned int c);
+
+    // true if a neighbour of v has its color
+    bool in_conflict(unsigned int v) const;
+
+    // smallest color in [1, limit] not used by a neighbour of v, 0 if there is none
+    unsigned int free_color(unsigned int v, unsigned int limit) const;
+
+    // tabu search until deadline for a conflict free coloring with colors colors of the region radius hops around the
+    // conflicted nodes, the nodes outside keep their color. Leaves the coloring with the fewest conflicts found, the
+    // nodes still in conflict in conflicted, and returns false if a deeper region would not be any larger
+    bool local_search(std::chrono::steady_clock::time_point deadline, unsigned int radius);
+
+    // empties the highest color classes into the lower colors while possible, then numbers the colors from 1
+    void compact();
+};
+
+// edge added to or removed from a graph, 0-based nodes
+struct edge_update {
+    bool add;
+    unsigned int i, j;
+};
+
+// reads a file of updates of a graph of the given number of nodes: "a u v" adds the edge (u, v), "d u v" removes it
+// (1-based nodes, as in DIMACS), "r" ends a batch of updates to repair at once, "c" starts a comment. Returns the non
+// empty batches in order, a node out of range or a self loop is an error
+std::vector<std::vector<edge_update>> load_updates(const std::string& file_path, unsigned int nodes);
+
+#include "../src/incremental.tpp"
+
+#endif //INCREMENTAL_H
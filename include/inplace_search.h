@@ -0,0 +1,86 @@
+#ifndef INPLACE_SEARCH_H
+#define INPLACE_SEARCH_H
+
+#include <vector>
+
+#include "context.h"
+#include "graph.h"
+
+// depth-first branch and bound over a single coloring colored and uncolored in place, shared by the engines that work
+// that way. The loop here handles the bounds, the dominance pruning, the budget, the statistics and the incumbent;
+// Engine (deriving from inplace_search<Engine, dim>) only branches and undoes, through
+//   unsigned int select_next(unsigned int last)      node to branch on after last was colored (g.size() at the root)
+//   unsigned int next_color(unsigned int v, unsigned int after, unsigned int max_color)
+//                                                    smallest color greater than after that v can take, 0 if none
+//   void assign(unsigned int v, unsigned int c, unsigned int depth)
+//   void undo(const frame& f, unsigned int depth)    reverts the assign() of frame f
+// and may hide the hooks visited() and out_of_budget()
+template<typename Engine, unsigned int dim>
+struct inplace_search {
+
+    explicit inplace_search(context<dim>& ctx);
+
+    context<dim>& ctx;
+
+    const graph<dim>& g;
+
+    // best coloring found so far (colors in [1, ctx.colors_ub]), empty if none
+    storage_t<unsigned int, dim> best;
+
+    // number of nodes colored during the search
+    unsigned long int tot_nodes_explored = 0;
+
+    // sets a complete valid coloring as incumbent, only better colorings are searched afterwards
+    void seed(const storage_t<unsigned int, dim>& coloring);
+
+    // true if best holds a complete coloring
+    bool found() const;
+
+protected:
+
+    // search state at a given depth
+    struct frame {
+        unsigned int node;          // node colored at this depth
+        unsigned int color;         // color currently assigned to it, 0 before the first one is tried
+        unsigned int tot_colors;    // colors used before node was colored
+    };
+
+    // current coloring: 0 -> color not assigned yet
+    storage_t<unsigned int, dim> color;
+
+    std::vector<frame> frames;
+
+    unsigned int tot_colors = 0;
+
+    bool has_best = false;
+
+    // true if there is nothing to search: the graph is empty (best is then its empty coloring) or the incumbent
+    // already matches ctx.colors_lb
+    bool settled();
+
+    // colors the nodes of clique 1, 2, ... for good, at depth g.size(), and returns the number of nodes left. If none
+    // is left the coloring is kept as best when it is better
+    unsigned int color_root(const std::vector<unsigned int>& clique);
+
+    // explores the tree below frames[depth], the frames above it being colored, until it is exhausted, ctx.colors_ub
+    // reaches ctx.colors_lb or ctx.budget is spent. free_nodes is the depth of a complete coloring. Returns true if
+    // the budget stopped it
+    bool search(unsigned int depth, unsigned int free_nodes);
+
+    // called once a node is colored, with the depth of the frames colored
+    void visited(unsigned int) {}
+
+    // called when the budget stops the search, with the depth of the frames colored
+    void out_of_budget(unsigned int) {}
+
+private:
+
+    Engine& self();
+
+    // keeps the current complete coloring as best
+    void keep_best();
+};
+
+#include "../src/inplace_search.tpp"
+
+#endif //INPLACE_SEARCH_H
@@ -0,0 +1,100 @@
+#ifndef MPI_SEARCH_H
+#define MPI_SEARCH_H
+
+#ifdef GC_WITH_MPI
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <mpi.h>
+
+#include "solution.h"
+
+// branch and bound distributed over the ranks of an MPI communicator. Every rank loads the whole graph and expands
+// the same breadth-first frontier near the root, then keeps the subtrees of index rank, rank + size, ... (static
+// partition). Ranks explore depth-first and, once idle, ask a random rank for work: the victim hands over its oldest
+// node, i.e. the largest open subtree. Improved bounds are sent to every rank as they are found, so all ranks prune
+// against the global best. Termination is detected with Safra's token ring algorithm over the work messages.
+// Each search runs on a duplicate of the communicator and ends with no message in flight, so that one search (e.g.
+// per component with --reduce) can follow another on the same ranks
+template<unsigned int dim>
+struct mpi_search {
+
+    // duplicates comm, freed with the search
+    mpi_search(context<dim>& ctx, MPI_Comm comm);
+
+    mpi_search(const mpi_search&) = delete;
+    mpi_search& operator=(const mpi_search&) = delete;
+
+    ~mpi_search();
+
+    context<dim>& ctx;
+
+    // searches the whole tree and returns the best solution over all ranks (on every rank), or a placeholder
+    // solution<dim>() if the budget stopped every rank before a complete one. incumbent is the (optional) solution
+    // known by this rank: colors_ub is first reduced to the minimum over all ranks
+    solution<dim> run(const solution<dim>* incumbent);
+
+    // nodes explored, summed over all ranks
+    unsigned long int tot_solutions_generated = 0;
+
+    int rank = 0, size = 1;
+
+private:
+
+    enum tag : int { tag_request = 1, tag_work, tag_no_work, tag_ub, tag_token, tag_terminate };
+
+    // nodes are polled for messages every poll_interval nodes explored
+    static constexpr unsigned int poll_interval = 256;
+
+    MPI_Comm comm = MPI_COMM_NULL;
+
+    // non-blocking sends not known to be matched yet, and the bounds they send (a deque never moves its elements)
+    std::vector<MPI_Request> sends;
+    std::deque<unsigned int> sent_ubs;
+
+    std::deque<solution<dim>> stack;
+
+    solution<dim> best_so_far;
+    bool has_best = false;
+
+    unsigned long int explored = 0;
+
+    // a work request was sent and has not been answered yet
+    bool request_pending = false;
+
+    // Safra's termination detection: work messages sent minus received, process color and token state
+    long msg_count = 0;
+    bool black = false;
+    bool has_token = false;
+    bool token_black = false;
+    long token_count = 0;
+    bool token_out = false;
+    bool terminated = false;
+
+    std::mt19937 gen;
+
+    // processes a single node, pushing its children on the stack
+    void process(const solution<dim>& curr);
+
+    // handles all the messages received so far
+    void poll();
+
+    // passes the token on (or, on rank 0, checks for termination) if this rank is idle
+    void handle_token();
+
+    void broadcast_ub(unsigned int ub);
+
+    // synchronous non-blocking send of an empty message, tracked in sends
+    void send_empty(int to, tag t);
+
+    // polls until every rank has its sends matched: no message of this search is left in flight
+    void drain();
+};
+
+#include "../src/mpi_search.tpp"
+
+#endif // GC_WITH_MPI
+
+#endif //MPI_SEARCH_H
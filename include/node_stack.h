@@ -0,0 +1,48 @@
+#ifndef NODE_STACK_H
+#define NODE_STACK_H
+
+#include <cstddef>
+#include <vector>
+
+#include "solution.h"
+
+// LIFO store of the search nodes of the stack engine, in one contiguous buffer reserved up front. Popped slots are
+// not destroyed: the next node pushed there is copied into the storage the slot already owns, so once the slots of
+// dynamic_dim solutions have been sized the search does no allocation at all
+template<unsigned int dim>
+struct node_stack {
+
+    // room for capacity nodes before the buffer has to grow
+    explicit node_stack(std::size_t capacity);
+
+    bool empty() const;
+
+    std::size_t size() const;
+
+    // largest number of nodes held at once
+    std::size_t peak() const;
+
+    solution<dim>& top();
+
+    // slot on top of the stack, holding whatever node lived there before: the caller overwrites it
+    solution<dim>& push();
+
+    void pop();
+
+    // pops every node
+    void clear();
+
+    // makes room for n more nodes, so that no reference to a node is invalidated by the next n push()
+    void reserve(std::size_t n);
+
+private:
+
+    std::vector<solution<dim>> slots;
+
+    std::size_t used = 0;
+    std::size_t max_used = 0;
+};
+
+#include "../src/node_stack.tpp"
+
+#endif //NODE_STACK_H
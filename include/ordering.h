@@ -0,0 +1,81 @@
+#ifndef ORDERING_H
+#define ORDERING_H
+
+#include <string>
+#include <vector>
+
+#include "graph.h"
+
+// policy used to pick the node to branch on
+enum class selection {
+    input,          // node order of the input file
+    degree,         // static order, decreasing degree
+    smallest_last,  // static order, reverse of the repeated removal of a minimum degree node
+    dsatur          // dynamic order, maximum saturation (distinct neighbour colors), ties broken by degree
+};
+
+// parses a policy name as given on the command line: input, degree, smallest-last or dsatur
+selection parse_selection(const std::string& name);
+
+// nodes sorted by decreasing degree (ties by index)
+template<unsigned int dim>
+std::vector<unsigned int> degree_order(const graph<dim>& g);
+
+// smallest-last (degeneracy) order of the nodes
+template<unsigned int dim>
+std::vector<unsigned int> smallest_last_order(const graph<dim>& g);
+
+// renumbering of the nodes applied when a graph is loaded: neighbours get close indices, so the rows touched by a
+// node expansion share cache lines, and the input order becomes a good static branching order
+enum class renumbering {
+    none,
+    degree,         // decreasing degree
+    degeneracy,     // smallest-last order
+    rcm             // reverse Cuthill-McKee: breadth-first by increasing degree, reversed, for a narrow band
+};
+
+// parses a renumbering name as given on the command line: none, degree, degeneracy or rcm
+renumbering parse_renumbering(const std::string& name);
+
+// reverse Cuthill-McKee order, each connected component started from a node of smallest degree
+template<unsigned int dim>
+std::vector<unsigned int> rcm_order(const graph<dim>& g);
+
+// new order of the nodes of g: node i of the renumbered graph, graph(g, order), is node order[i] of g. Empty for
+// renumbering::none
+template<unsigned int dim>
+std::vector<unsigned int> renumbering_order(const graph<dim>& g, renumbering r);
+
+// coloring of the original graph from a coloring of the graph renumbered by order
+template<unsigned int dim>
+storage_t<unsigned int, dim> original_coloring(const storage_t<unsigned int, dim>& coloring,
+                                               const std::vector<unsigned int>& order);
+
+// picks the next node to color according to a selection policy
+template<unsigned int dim>
+struct node_selector {
+
+    node_selector(const graph<dim>& g, selection policy);
+
+    selection policy;
+
+    // static branching order (identity for input, unused for dsatur) and position of each node in it
+    std::vector<unsigned int> order;
+    std::vector<unsigned int> rank;
+
+    // degree of each node, tie-breaker of dsatur
+    std::vector<unsigned int> degree;
+
+    // returns the node to branch on after last was colored (last == size() at the root), or size() if every node
+    // is colored. color(i) != 0 tells whether node i is colored, saturation(i) is its number of forbidden colors.
+    template<typename Color, typename Saturation>
+    unsigned int next(unsigned int last, Color&& color, Saturation&& saturation) const;
+
+    // same as next() for a single_word_dim graph, the uncolored nodes given as the bitset open
+    template<typename Saturation>
+    unsigned int next_open(unsigned int last, uint64_t open, Saturation&& saturation) const;
+};
+
+#include "../src/ordering.tpp"
+
+#endif //ORDERING_H
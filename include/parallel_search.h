@@ -0,0 +1,63 @@
+#ifndef PARALLEL_SEARCH_H
+#define PARALLEL_SEARCH_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "solution.h"
+
+// multithreaded branch and bound over solution<dim> nodes. The tree is first expanded breadth-first near the root
+// and the subtrees are dealt to per-thread deques. Each thread explores its own deque depth-first (LIFO end) and,
+// once it runs dry, steals the oldest node (closest to the root, hence the largest subtree) of another thread.
+// The incumbent bound is shared through the atomic ctx.colors_ub.
+template<unsigned int dim>
+struct parallel_search {
+
+    parallel_search(context<dim>& ctx, unsigned int threads);
+
+    context<dim>& ctx;
+
+    // searches the whole tree and returns the best solution found. incumbent (optional) is a known complete solution,
+    // only better ones are searched; if null, colors_ub must not be lower than the number of nodes
+    solution<dim> run(const solution<dim>* incumbent);
+
+    // nodes explored, over all threads
+    unsigned long int tot_solutions_generated = 0;
+
+    const unsigned int threads;
+
+private:
+
+    struct worker {
+        std::deque<solution<dim>> q;
+        std::mutex m;
+        unsigned long int explored = 0;
+    };
+
+    std::vector<std::unique_ptr<worker>> workers;
+
+    // nodes pushed and not yet fully processed: the search is over when it drops to zero
+    std::atomic<unsigned long int> pending{0};
+
+    // set once the incumbent is proven optimal
+    std::atomic<bool> done{false};
+
+    std::mutex best_mutex;
+    solution<dim> best_so_far;
+    bool has_best = false;
+
+    // processes a single node, pushing its children on the deque of worker id
+    void process(unsigned int id, const solution<dim>& curr);
+
+    // takes a node from the own deque, or steals one, returns false if none was found
+    bool take(unsigned int id, solution<dim>& out);
+
+    void work(unsigned int id);
+};
+
+#include "../src/parallel_search.tpp"
+
+#endif //PARALLEL_SEARCH_H
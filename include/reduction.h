@@ -0,0 +1,42 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+// what is left of a graph once the nodes that never affect its chromatic number are removed, split into connected
+// components that can be colored independently, together with what is needed to color the removed nodes afterwards
+struct reduction {
+
+    // node i of components[k] is node nodes[k][i] of the original graph
+    std::vector<graph<dynamic_dim>> components;
+    std::vector<std::vector<unsigned int>> nodes;
+
+    // removed nodes in removal order, each with the node it is dominated by, or -1 if it was peeled for its degree
+    std::vector<std::pair<unsigned int, unsigned int>> removed;
+
+    // number of nodes left in the components
+    unsigned int core_size() const;
+};
+
+// reduces g, given a lower bound lb on its number of colors:
+// - a node with fewer than lb neighbours is peeled: whatever the coloring of the rest, one of the first lb colors is
+//   free for it;
+// - a node u whose neighbours are all neighbours of a node v not adjacent to u is dominated: it can take the color of
+//   v.
+// Both rules are applied until neither removes a node. Any coloring of the components with k >= lb colors extends to
+// the whole graph with k colors, so the chromatic number of g is max(lb, chromatic number of each component)
+template<unsigned int dim>
+reduction reduce(const graph<dim>& g, unsigned int lb);
+
+// coloring of g made of the colorings of the components of r (colorings[k] colors components[k]), extended to the
+// removed nodes in reverse removal order
+template<unsigned int dim>
+storage_t<unsigned int, dim> restore(const graph<dim>& g, const reduction& r,
+                                     const std::vector<std::vector<unsigned int>>& colorings);
+
+#include "../src/reduction.tpp"
+
+#endif //REDUCTION_H
@@ -0,0 +1,90 @@
+#ifndef SEARCH_STRATEGY_H
+#define SEARCH_STRATEGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "context.h"
+#include "node_stack.h"
+#include "solution.h"
+
+// order in which the sequential engine explores the open nodes of the search tree
+enum class strategy {
+    dfs,            // depth-first, children in increasing color order
+    best_first,     // smallest bound first, the deepest node among equal bounds
+    lds,            // limited discrepancy search: paths straying at most d times from the first color, d = 0, 1, ...
+    hybrid          // best-first until the open list reaches the memory cap, then depth-first below its best node
+};
+
+// parses a strategy name as given on the command line: dfs, best-first, lds or hybrid
+strategy parse_strategy(const std::string& name);
+
+// incumbent of a sequential search and the rules shared by all the strategies: which nodes are worth expanding and
+// which complete solutions are kept
+template<unsigned int dim>
+struct search_state {
+
+    // incumbent (optional) is a known complete solution, only better ones are searched
+    search_state(context<dim>& ctx, const solution<dim>* incumbent);
+
+    context<dim>& ctx;
+
+    // best complete solution so far, meaningful once found is set. ctx.colors_ub is its number of colors
+    solution<dim> best;
+    bool found = false;
+
+    // nodes taken from the open list
+    unsigned long int tot_solutions_generated = 0;
+
+    // feasible colors of the node being expanded
+    std::vector<unsigned int> colors;
+
+    // nodes not charged to ctx.budget yet
+    unsigned long int budget_nodes = 0;
+
+    // true once best matches ctx.colors_lb
+    bool optimal() const;
+
+    // true if the subtree of s may hold a solution better than best (the first solution is always accepted)
+    bool worth_expanding(const solution<dim>& s) const;
+
+    // keeps s as best if it is complete and better, returns true if it did
+    bool offer(const solution<dim>& s);
+
+    // counts a node taken from an open list holding open nodes, for the engines and ctx.stats
+    void visit(std::size_t open);
+
+    // records in ctx.stats a subtree cut by the bound, and colors rejected as infeasible
+    void pruned();
+    void rejected(unsigned int colors);
+
+    // charges a node to ctx.budget, true once the budget is spent and the search must unwind
+    bool out_of_budget();
+
+    // true once ctx.budget is spent
+    bool stopped() const;
+};
+
+// explores the subtrees of the nodes on q until q is empty or the incumbent is optimal
+template<unsigned int dim>
+void depth_first(search_state<dim>& state, node_stack<dim>& q);
+
+// best-first search over a priority queue keyed by solution::bound(). With memory_cap != 0 (bytes), the open list
+// stops growing at that size: the best node is then searched depth-first to the end instead of being expanded
+template<unsigned int dim>
+void best_first(search_state<dim>& state, std::size_t memory_cap);
+
+// limited discrepancy search, restarted with a discrepancy limit one higher until an iteration was not cut by it.
+// A discrepancy is a branch on any color but the first feasible one
+template<unsigned int dim>
+void limited_discrepancy(search_state<dim>& state);
+
+// searches the tree of ctx with the given strategy (memory_cap only matters to hybrid) and returns the best solution
+template<unsigned int dim>
+solution<dim> sequential_search(context<dim>& ctx, const solution<dim>* incumbent, strategy order,
+                                std::size_t memory_cap, unsigned long int& tot_solutions_generated);
+
+#include "../src/search_strategy.tpp"
+
+#endif //SEARCH_STRATEGY_H
@@ -0,0 +1,44 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstdint>
+
+// kernels working on a bitset row of the adjacency matrix (words 64-bit words over the nodes [0, n)) next to the
+// color array of the nodes. Each one has a scalar version and AVX2 / AVX-512 versions compiled through target
+// attributes, so the binary runs on any x86-64 CPU: the version is picked at runtime from the CPU features
+
+// instruction sets the kernels can use, in increasing order
+enum class simd_level {
+    scalar,
+    avx2,
+    avx512      // AVX-512 F and BW
+};
+
+// best level supported by the CPU, detected once. The environment variable GC_SIMD (scalar, avx2 or avx512) can
+// lower it, to compare the versions
+simd_level active_simd();
+
+const char* simd_name(simd_level level);
+
+// adds to set (set_words words) the colors of the nodes of row, color 0 (not colored) excluded: the forbidden colors
+// of the node the row belongs to. C is the color type of the solution (uint8_t, uint16_t or uint32_t), colors past
+// the set are dropped
+template<typename C>
+void row_colors(const uint64_t* row, unsigned int words, const C* colors, unsigned int n, uint64_t* set,
+                unsigned int set_words);
+
+// DSATUR saturation update after a node of the given row took color c: seen holds the nodes already next to color
+// c. Writes to fresh the nodes of row in open (the uncolored ones) that were not in seen, whose saturation goes up by
+// one, adds row to seen and returns the number of fresh nodes
+unsigned int row_saturate(const uint64_t* row, uint64_t* seen, const uint64_t* open, uint64_t* fresh,
+                          unsigned int words);
+
+// bitset of the nodes i < n with colors[i] == c, for n <= 64 known at compile time: with adjacency rows of one word,
+// ANDing it with a row gives the neighbours of color c in one operation. Byte colors are compared eight at a time
+// within a 64-bit word, with no branch and no runtime dispatch
+template<unsigned int n, typename C>
+uint64_t color_mask(const C* colors, C c);
+
+#include "../src/simd.tpp"
+
+#endif //SIMD_H
@@ -2,58 +2,124 @@
 #define SOLUTION_H
 
 #include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
+#include "context.h"
 #include "graph.h"
 
+// element type of solution<dim>::color: the smallest unsigned type holding every color in [0, dim]. A dynamic_dim
+// solution uses 16 bits, checked at runtime against the colors its context allows
+template<unsigned int dim>
+using color_t = std::conditional_t<dim != dynamic_dim && dim <= std::numeric_limits<uint8_t>::max(), uint8_t,
+                std::conditional_t<dim == dynamic_dim || dim <= std::numeric_limits<uint16_t>::max(), uint16_t,
+                                   uint32_t>>;
+
 template<unsigned int dim>
 struct solution {
     // nodes are numbered   [0 to dim-1]
     // colors are numbered  [1 to dim (at most)]
 
-    static graph<dim>* g;
-
-    // upper bound on number of colors to use
-    static unsigned int colors_ub;
+    // this array contains the color (repr as an integer) of each node: 0 -> color not assigned yet. Stored on
+    // color_t<dim> to keep the copies made for every child small
+    storage_t<color_t<dim>, dim> color;
 
-    // this array contains the color (repr as an integer) of each node: 0 -> color not assigned yet
-    std::array<unsigned int, dim> color;
+    // forbidden colors of each node, one bitset of color_words() words per node: bit c of node i is set if some
+    // neighbour of i already has color c. Kept up to date by the child constructor, in O(degree) per colored node.
+    // Sized from ctx.max_colors on the heap: a fixed bound of dim colors would make it the bulk of every node
+    // (dim * dim bits) when the graph needs far fewer colors.
+    // A single_word_dim solution stores it by color instead, inline: forbidden[c] is the set of nodes with a neighbour
+    // of color c, one word per color, and coloring a node is a single OR of its row
+    storage_t<uint64_t, single_word_dim<dim> ? dim + 1 : dynamic_dim> forbidden;
 
     // total number of colors used
     unsigned int tot_colors;
 
-    // index of the first node without a color
+    // number of colored nodes, the solution is final once it reaches size()
+    unsigned int colored;
+
+    // index of the node to color next, -1 once every node is colored
     unsigned int next;
 
-    // constructor for an empty solution
+    // placeholder solution, with no node when dim is dynamic_dim
     solution();
 
-    // returns true if all nodes are assigned a color
+    // constructor for the root solution of the graph of ctx: empty, except for the nodes of ctx.root_clique
+    explicit solution(const context<dim>& ctx);
+
+    // constructor for a (possibly partial) coloring given as the color of each node, 0 -> color not assigned yet
+    solution(const context<dim>& ctx, const storage_t<unsigned int, dim>& coloring);
+
+    // number of nodes
+    unsigned int size() const;
+
+    // color of each node, widened to unsigned int
+    storage_t<unsigned int, dim> coloring() const;
+
+    // number of words of the forbidden color set of a node (colors are in [1, ctx.max_colors]), unused for a
+    // single_word_dim solution
+    unsigned int color_words() const;
+
+    // number of colors that node i cannot take, given the nodes colored so far
+    unsigned int saturation(unsigned int i) const;
+
+    // returns true if all nodes are assigned a color, in O(1)
     bool is_final() const;
 
+    // lower bound on the number of colors of any complete solution in the subtree of this one: at least colors_lb and
+    // tot_colors, plus a new color if the next node already sees every color used so far
+    unsigned int bound(const context<dim>& ctx) const;
+
     // checks whether a solution is valid, with respect with a single node
     // i.e. checks whether a node has neighbours of the same color
-    bool is_valid(unsigned int node_to_check) const;
+    bool is_valid(const context<dim>& ctx, unsigned int node_to_check) const;
 
     // returns a list of solutions, "children" of this, each one has a different color for the selected node
-    std::vector<solution<dim>> get_next() const;
+    // If rejected is not null, it is set to the number of colors skipped because a neighbour of the node has them
+    std::vector<solution<dim>> get_next(const context<dim>& ctx, unsigned int* rejected = nullptr) const;
+
+    // writes the colors of the children of this to out, in increasing order, and returns how many there are. out
+    // must have room for ctx.max_colors + 1 colors. rejected is as for get_next()
+    unsigned int next_colors(const context<dim>& ctx, unsigned int* out, unsigned int* rejected = nullptr) const;
+
+    // turns this into its child where the selected node has color c, in place
+    void color_next(const context<dim>& ctx, unsigned int c);
+
+    // makes this the child of parent where the selected node has color c, reusing the storage of this
+    void assign_child(const context<dim>& ctx, const solution<dim>& parent, unsigned int c);
 
     friend std::ostream& operator<<(std::ostream& os, const solution<dim>& sol) {
         os << "Solution:\t\t[ ";
-        for (unsigned int i = 0; i < dim - 1; ++i)
-            os << sol.color[i] << ", ";
-        os << sol.color[dim - 1] << " ]\n";
+        for (unsigned int i = 0; i + 1 < sol.size(); ++i)
+            os << +sol.color[i] << ", ";
+        if (sol.size() > 0)
+            os << +sol.color[sol.size() - 1];
+        os << " ]\n";
         os << "Total colors:\t" << sol.tot_colors << "\n";
         os << "Next:\t\t\t" << sol.next << "\n";
-        os << "Color ub:\t\t" << colors_ub << "\n";
 
         return os;
     }
 
 private:
 
+    // color_words() of a solution with heap forbidden sets, taken from the context
+    unsigned int cw = bit_words(dim + 1);
+
     // constructor for the "child" of the solution
-    solution(const solution<dim>& parent, const unsigned int node_to_color, const unsigned int node_color);
+    solution(const context<dim>& ctx, const solution<dim>& parent, const unsigned int node_to_color,
+             const unsigned int node_color);
+
+    // set of colors that node i cannot take, not for a single_word_dim solution
+    const uint64_t* forbidden_colors(unsigned int i) const;
+
+    // gives color node_color to node, and forbids it on the neighbours of node
+    void paint(const context<dim>& ctx, unsigned int node, unsigned int node_color);
+
+    // node to branch on after last was colored (last == size() at the root), -1 if every node is colored
+    unsigned int select_next(const context<dim>& ctx, unsigned int last) const;
 };
 
 #include "../src/solution.tpp"
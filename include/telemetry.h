@@ -0,0 +1,84 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// live counters of one search. Each search thread only writes its own slot, with plain relaxed stores, so the
+// engines pay no atomic read-modify-write; a stats_reporter thread samples the slots while the search runs
+struct search_stats {
+
+    // counters of one search thread, on a cache line of their own
+    struct alignas(64) counters {
+        std::atomic<uint64_t> nodes{0};
+        std::atomic<uint64_t> depth{0};             // current stack (or open list) size
+        std::atomic<uint64_t> peak_depth{0};
+        std::atomic<uint64_t> prune_bound{0};       // subtrees cut because they cannot beat the incumbent
+        std::atomic<uint64_t> prune_infeasible{0};  // colors skipped because a neighbour already has them
+    };
+
+    explicit search_stats(unsigned int threads = 1);
+
+    // counters written by search thread id (ids past the number of slots share them)
+    counters& slot(unsigned int id);
+
+    // adds n to a counter only written by the calling thread
+    static void bump(std::atomic<uint64_t>& c, uint64_t n = 1);
+
+    // records the current depth of thread id, and its peak
+    void set_depth(unsigned int id, uint64_t depth);
+
+    // records that an incumbent with the given number of colors was found now
+    void improvement(unsigned int colors);
+
+    // seconds since the stats were created
+    double elapsed() const;
+
+    std::vector<counters> threads;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // (time in seconds, colors) of every incumbent improvement, in order
+    std::vector<std::pair<double, unsigned int>> improvements;
+    mutable std::mutex improvements_mutex;
+};
+
+// thread writing a snapshot of some search_stats every period: a line of text on stderr, or a JSON object per line
+// appended to a file. The last snapshot is written when the reporter is destroyed
+struct stats_reporter {
+
+    stats_reporter(const search_stats& stats, double period_s, const std::string& json_path = "");
+
+    ~stats_reporter();
+
+    stats_reporter(const stats_reporter&) = delete;
+    stats_reporter& operator=(const stats_reporter&) = delete;
+
+private:
+
+    const search_stats& stats;
+    const double period_s;
+    const std::string json_path;
+
+    // nodes and time at the previous snapshot, for the node rate
+    uint64_t last_nodes = 0;
+    double last_time = 0;
+
+    bool stop = false;
+    std::mutex m;
+    std::condition_variable cv;
+    std::thread reporter;
+
+    void report();
+};
+
+#include "../src/telemetry.tpp"
+
+#endif //TELEMETRY_H
@@ -1,7 +0,0 @@
-#include <cstdio>
-
-int main(){
-  printf("Hello World\n");
-
-  return 0;
-}
\ No newline at end of file
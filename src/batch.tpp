@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "../include/budget.h"
+#include "../include/clique.h"
+#include "../include/graph.h"
+#include "../include/heuristics.h"
+
+inline std::vector<std::string> batch_inputs(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+
+    if (fs::is_directory(path)) {
+        for (const auto& entry : fs::directory_iterator(path)) {
+            const std::string ext = entry.path().extension().string();
+            if (entry.is_regular_file() && (ext == ".col" || ext == ".gcb")) files.push_back(entry.path().string());
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    std::ifstream list(path);
+    if (!list) {
+        throw std::runtime_error("Error: Unable to open file " + path);
+    }
+    for (std::string line; std::getline(list, line);) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) line.pop_back();
+        if (!line.empty() && line[0] != '#') files.push_back(line);
+    }
+    return files;
+}
+
+template<typename Color>
+batch_result solve_one(const std::string& file, const batch_options& opt, Color&& color) {
+    const auto start = std::chrono::steady_clock::now();
+    batch_result r;
+    r.file = file;
+
+    try {
+        graph<dynamic_dim> g(file);
+        r.nodes = g.size();
+        r.edges = g.edges();
+        const std::vector<unsigned int> order = renumbering_order(g, opt.renumber);
+        if (!order.empty()) g = graph<dynamic_dim>(g, order);
+
+        search_budget budget(opt.time_limit, opt.node_limit);
+        const auto colors_lb = static_cast<unsigned int>(greedy_clique(g).size());
+        auto best = color(std::as_const(g), budget, colors_lb, r.explored);
+
+        if (!order.empty()) best = original_coloring<dynamic_dim>(best, order);
+        r.coloring.assign(best.begin(), best.end());
+        r.colors = colors_used<dynamic_dim>(best);
+        r.colors_lb = std::min(colors_lb, r.colors);
+        r.optimal = !budget.stopped() || r.colors <= colors_lb;
+    } catch (const std::exception& e) {
+        r.error = e.what();
+    }
+
+    r.time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+template<typename Color, typename Sink>
+void solve_batch(const std::vector<std::string>& files, const batch_options& opt, Color&& color, Sink&& sink) {
+    std::atomic<std::size_t> next{0};
+    std::mutex sink_mutex;
+
+    const auto work = [&] {
+        for (std::size_t k; (k = next.fetch_add(1)) < files.size();) {
+            if (search_budget::signalled()) return;
+            batch_result r = solve_one(files[k], opt, color);
+            std::lock_guard lock(sink_mutex);
+            sink(r);
+        }
+    };
+
+    const auto workers = static_cast<unsigned int>(std::min<std::size_t>(std::max(opt.threads, 1u), files.size()));
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < workers; ++t)
+        pool.emplace_back(work);
+    work();
+    for (auto& t : pool)
+        t.join();
+}
+
+// s as the contents of a JSON string
+inline std::string json_escape(const std::string& s) {
+    std::string out;
+    for (const char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+            out += ch;
+        } else if (static_cast<unsigned char>(ch) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(ch)));
+            out += code;
+        } else {
+            out += ch;
+        }
+    }
+    return out;
+}
+
+inline void write_json_line(std::ostream& out, const batch_result& r, const bool with_coloring) {
+    std::string line = "{\"file\": \"" + json_escape(r.file) + "\"";
+    if (!r.error.empty()) {
+        line += ", \"error\": \"" + json_escape(r.error) + "\"}\n";
+        out << line << std::flush;
+        return;
+    }
+
+    char fields[256];
+    std::snprintf(fields, sizeof(fields),
+                  ", \"nodes\": %u, \"edges\": %lu, \"colors\": %u, \"lower_bound\": %u, \"optimal\": %s, "
+                  "\"explored\": %lu, \"time_ms\": %.3f",
+                  r.nodes, r.edges, r.colors, r.colors_lb, r.optimal ? "true" : "false", r.explored, r.time_ms);
+    line += fields;
+    if (with_coloring) {
+        line += ", \"coloring\": [";
+        for (std::size_t i = 0; i < r.coloring.size(); ++i) {
+            if (i) line += ", ";
+            line += std::to_string(r.coloring[i]);
+        }
+        line += "]";
+    }
+    line += "}\n";
+    out << line << std::flush;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+inline bool test_bit(const uint64_t* bits, const unsigned int i) {
+    return (bits[i / 64] >> (i % 64)) & 1;
+}
+
+inline void set_bit(uint64_t* bits, const unsigned int i) {
+    bits[i / 64] |= uint64_t{1} << (i % 64);
+}
+
+inline void clear_bit(uint64_t* bits, const unsigned int i) {
+    bits[i / 64] &= ~(uint64_t{1} << (i % 64));
+}
+
+inline unsigned int count_bits(const uint64_t* bits, const unsigned int words) {
+    unsigned int c = 0;
+    for (unsigned int k = 0; k < words; ++k)
+        c += std::popcount(bits[k]);
+    return c;
+}
+
+template<typename F>
+void for_each_bit(const uint64_t* bits, const unsigned int words, F&& f) {
+    for (unsigned int k = 0; k < words; ++k)
+        for (uint64_t w = bits[k]; w != 0; w &= w - 1)
+            f(k * 64 + std::countr_zero(w));
+}
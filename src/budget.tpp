@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <csignal>
+#include <limits>
+
+inline const char* stop_reason_name(const stop_reason reason) {
+    switch (reason) {
+    case stop_reason::time_limit: return "time limit";
+    case stop_reason::node_limit: return "node limit";
+    case stop_reason::signal: return "interrupted";
+    default: return "none";
+    }
+}
+
+inline search_budget::search_budget(const double time_limit, const unsigned long int node_limit)
+    : time_limit(time_limit), node_limit(node_limit),
+      check_every(node_limit != 0 ? std::min(node_limit, 1024ul) : 1024ul) {}
+
+inline bool search_budget::charge(unsigned long int& local) {
+    if (++local < check_every) return stopped();
+
+    const unsigned long int total = nodes.fetch_add(local, std::memory_order_relaxed) + local;
+    local = 0;
+    if (interrupted.load(std::memory_order_relaxed)) stop(stop_reason::signal);
+    if (node_limit != 0 && total >= node_limit) stop(stop_reason::node_limit);
+    if (time_limit > 0 && elapsed() >= time_limit) stop(stop_reason::time_limit);
+    return stopped();
+}
+
+inline bool search_budget::stopped() const {
+    return why.load(std::memory_order_relaxed) != stop_reason::none || interrupted.load(std::memory_order_relaxed);
+}
+
+inline stop_reason search_budget::reason() const {
+    const stop_reason r = why.load();
+    return r == stop_reason::none && interrupted.load() ? stop_reason::signal : r;
+}
+
+inline double search_budget::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline double search_budget::remaining() const {
+    if (time_limit <= 0) return std::numeric_limits<double>::infinity();
+    return std::max(0.0, time_limit - elapsed());
+}
+
+inline void search_budget::catch_signals() {
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+}
+
+inline bool search_budget::signalled() {
+    return interrupted.load(std::memory_order_relaxed);
+}
+
+inline void search_budget::on_signal(const int sig) {
+    interrupted.store(true, std::memory_order_relaxed);
+    // the next one is not caught
+    std::signal(sig, SIG_DFL);
+}
+
+inline void search_budget::stop(const stop_reason reason) {
+    stop_reason none = stop_reason::none;
+    why.compare_exchange_strong(none, reason);
+}
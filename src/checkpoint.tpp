@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+inline void checkpoint::save(const std::string& file_path) const {
+    const std::string tmp_path = file_path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Error: Unable to write file " + tmp_path);
+        }
+
+        checkpoint_header header{};
+        std::memcpy(header.magic, checkpoint_magic, sizeof(checkpoint_magic));
+        header.nodes = nodes;
+        header.root_clique = root_clique;
+        header.edges = edges;
+        header.explored = explored;
+        header.colors_ub = colors_ub;
+        header.depth = static_cast<uint32_t>(path.size());
+        header.has_best = !best.empty();
+        header.done = done;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::vector<uint32_t> raw(best.begin(), best.end());
+        for (const auto& [node, color] : path) {
+            raw.push_back(node);
+            raw.push_back(color);
+        }
+        file.write(reinterpret_cast<const char*>(raw.data()), static_cast<std::streamsize>(raw.size() * sizeof(uint32_t)));
+        if (!file) {
+            throw std::runtime_error("Error: Unable to write file " + tmp_path);
+        }
+    }
+    std::filesystem::rename(tmp_path, file_path);
+}
+
+inline checkpoint checkpoint::load(const std::string& file_path) {
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Error: Unable to open file " + file_path);
+    }
+
+    checkpoint_header header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, checkpoint_magic, sizeof(checkpoint_magic)) != 0) {
+        throw std::runtime_error("Error: Not a checkpoint file " + file_path);
+    }
+
+    checkpoint cp;
+    cp.nodes = header.nodes;
+    cp.root_clique = header.root_clique;
+    cp.edges = header.edges;
+    cp.explored = header.explored;
+    cp.colors_ub = header.colors_ub;
+    cp.done = header.done != 0;
+
+    std::vector<uint32_t> raw((header.has_best ? header.nodes : 0) + 2 * static_cast<std::size_t>(header.depth));
+    file.read(reinterpret_cast<char*>(raw.data()), static_cast<std::streamsize>(raw.size() * sizeof(uint32_t)));
+    if (!file) {
+        throw std::runtime_error("Error: Truncated checkpoint file " + file_path);
+    }
+    const std::size_t best_size = header.has_best ? header.nodes : 0;
+    cp.best.assign(raw.begin(), raw.begin() + best_size);
+    for (std::size_t k = best_size; k < raw.size(); k += 2)
+        cp.path.emplace_back(raw[k], raw[k + 1]);
+    return cp;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+
+#include "../include/ordering.h"
+
+template<unsigned int dim>
+std::vector<unsigned int> greedy_clique(const graph<dim>& g, const unsigned int max_starts) {
+    const std::vector<unsigned int> order = degree_order(g);
+    const unsigned int starts = std::min<unsigned int>(max_starts, g.size());
+
+    std::vector<unsigned int> best, clique;
+    std::vector<uint64_t> candidates(g.words());
+
+    for (unsigned int s = 0; s < starts; ++s) {
+        const unsigned int start = order[s];
+        // the clique cannot grow past degree + 1 nodes
+        if (g.degree(start) + 1 <= best.size()) break;
+
+        clique.assign(1, start);
+        std::fill(candidates.begin(), candidates.end(), 0);
+        g.for_each_neighbour(start, [&](const unsigned int v) { set_bit(candidates.data(), v); });
+
+        while (true) {
+            // candidate with most neighbours among the other candidates (word-wide AND + popcount)
+            unsigned int pick = g.size(), pick_degree = 0;
+            for_each_bit(candidates.data(), g.words(), [&](const unsigned int v) {
+                const unsigned int d = g.count_neighbours_in(v, candidates.data());
+                if (pick == g.size() || d > pick_degree) {
+                    pick = v;
+                    pick_degree = d;
+                }
+            });
+            if (pick == g.size()) break;
+
+            clique.push_back(pick);
+            g.intersect_neighbours(pick, candidates.data());
+        }
+
+        if (clique.size() > best.size()) best = clique;
+    }
+    return best;
+}
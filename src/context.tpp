@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "../include/clique.h"
+
+inline symmetry parse_symmetry(const std::string& name) {
+    if (name == "none") return symmetry::none;
+    if (name == "clique") return symmetry::clique;
+    if (name == "dominance") return symmetry::dominance;
+    throw std::runtime_error("Error: Unknown symmetry breaking " + name);
+}
+
+template<unsigned int dim>
+context<dim>::context(const graph<dim>& g, const node_selector<dim>* selector)
+    : g(g), max_colors(std::min(g.size(), g.max_degree() + 1)), selector(selector), colors_ub(g.size()) {}
+
+template<unsigned int dim>
+unsigned int context<dim>::color_words() const {
+    return bit_words(max_colors + 1);
+}
+
+template<unsigned int dim>
+bool context<dim>::improve_ub(const unsigned int ub) {
+    unsigned int curr = colors_ub.load();
+    while (ub < curr)
+        if (colors_ub.compare_exchange_weak(curr, ub)) return true;
+    return false;
+}
+
+template<unsigned int dim>
+template<typename Color, typename Saturation>
+unsigned int context<dim>::next_node(const unsigned int last, Color&& color, Saturation&& saturation) const {
+    if (selector) return selector->next(last, color, saturation);
+
+    // input order: the first node without a color
+    unsigned int node = last >= g.size() ? 0 : last + 1;
+    while (node < g.size() && color(node) != 0) ++node;
+    return node;
+}
+
+template<unsigned int dim>
+template<typename Saturation>
+unsigned int context<dim>::next_open_node(const unsigned int last, const uint64_t open, Saturation&& saturation) const {
+    if (selector) return selector->next_open(last, open, saturation);
+
+    // input order: the first open node after last
+    const uint64_t after = last >= dim ? open : open & ~((uint64_t{2} << last) - 1);
+    return after == 0 ? dim : static_cast<unsigned int>(std::countr_zero(after));
+}
+
+template<unsigned int dim>
+void context<dim>::break_symmetries(const symmetry level) {
+    root_clique.clear();
+    dominators.clear();
+    if (level == symmetry::none) return;
+
+    // sorted, so that the colors of the clique do not depend on how it was found
+    root_clique = greedy_clique(g);
+    std::sort(root_clique.begin(), root_clique.end());
+    if (level != symmetry::dominance) return;
+
+    dominators.resize(g.size());
+    for (unsigned int v = 0; v < g.size(); ++v) {
+        // a dominator is adjacent to every neighbour of v, in particular to the one of least degree
+        unsigned int pivot = g.size();
+        g.for_each_neighbour(v, [&](const unsigned int x) {
+            if (pivot == g.size() || g.degree(x) < g.degree(pivot)) pivot = x;
+        });
+        if (pivot == g.size()) continue;
+
+        g.for_each_neighbour(pivot, [&](const unsigned int u) {
+            if (u == v || g.degree(u) < g.degree(v) || g(u, v)) return;
+            bool covers = true;
+            if (!g.sparse()) {
+                const uint64_t* rv = g.row(v);
+                const uint64_t* ru = g.row(u);
+                for (unsigned int k = 0; covers && k < g.words(); ++k)
+                    covers = (rv[k] & ~ru[k]) == 0;
+            } else {
+                g.for_each_neighbour(v, [&](const unsigned int x) { covers = covers && g(u, x); });
+            }
+            if (covers) dominators[v].push_back(u);
+        });
+    }
+}
+
+template<unsigned int dim>
+template<typename Color>
+unsigned int context<dim>::forced_color(const unsigned int v, Color&& color) const {
+    if (dominators.empty()) return 0;
+    for (const unsigned int u : dominators[v])
+        if (color(u) != 0) return color(u);
+    return 0;
+}
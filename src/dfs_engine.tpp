@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+template<unsigned int dim>
+dfs_engine<dim>::dfs_engine(context<dim>& ctx) : base(ctx), forbidden{} {
+    if constexpr (dim == dynamic_dim) forbidden.assign(static_cast<std::size_t>(g.size()) * color_words(), 0);
+
+    // every node pushes at most degree entries on the trail, and the depth is at most size()
+    std::size_t tot_degree = 0;
+    for (unsigned int i = 0; i < g.size(); ++i)
+        tot_degree += g.degree(i);
+    trail.reserve(tot_degree);
+    trail_marks.resize(g.size() + 1);
+    if constexpr (single_word_dim<dim>) open = dim == 64 ? ~uint64_t{0} : (uint64_t{1} << dim) - 1;
+}
+
+template<unsigned int dim>
+void dfs_engine<dim>::resume(const checkpoint& cp) {
+    if (cp.nodes != g.size() || cp.edges != g.edges() || cp.root_clique != ctx.root_clique.size()) {
+        throw std::runtime_error("Error: Checkpoint does not match the graph or the symmetry breaking");
+    }
+    if (!cp.best.empty() && (!has_best || cp.colors_ub < ctx.colors_ub)) {
+        std::copy(cp.best.begin(), cp.best.end(), std::begin(best));
+        ctx.colors_ub = cp.colors_ub;
+        has_best = true;
+    }
+    tot_nodes_explored = cp.explored;
+    replay = cp.path;
+    finished = cp.done;
+}
+
+template<unsigned int dim>
+void dfs_engine<dim>::save_checkpoint(const unsigned int depth, const bool done) const {
+    checkpoint cp;
+    cp.nodes = g.size();
+    cp.edges = g.edges();
+    cp.root_clique = static_cast<unsigned int>(ctx.root_clique.size());
+    cp.colors_ub = ctx.colors_ub;
+    cp.explored = tot_nodes_explored;
+    cp.done = done;
+    if (has_best) cp.best.assign(std::begin(best), std::end(best));
+    for (unsigned int k = 0; k < depth; ++k)
+        cp.path.emplace_back(frames[k].node, frames[k].color);
+    cp.save(checkpoint_path);
+}
+
+template<unsigned int dim>
+unsigned int dfs_engine<dim>::color_words() const {
+    if constexpr (dim == dynamic_dim) return ctx.color_words();
+    else return bit_words(dim + 1);
+}
+
+template<unsigned int dim>
+uint64_t* dfs_engine<dim>::forbidden_colors(const unsigned int i) {
+    return forbidden.data() + static_cast<std::size_t>(i) * color_words();
+}
+
+template<unsigned int dim>
+unsigned int dfs_engine<dim>::select_next(const unsigned int last) {
+    if constexpr (single_word_dim<dim>)
+        return ctx.next_open_node(last, open,
+            [&](const unsigned int i) { return count_bits(forbidden_colors(i), color_words()); });
+    return ctx.next_node(last,
+        [&](const unsigned int i) { return color[i]; },
+        [&](const unsigned int i) { return count_bits(forbidden_colors(i), color_words()); });
+}
+
+template<unsigned int dim>
+void dfs_engine<dim>::assign(const unsigned int v, const unsigned int c, const unsigned int depth) {
+    trail_marks[depth] = trail.size();
+    color[v] = c;
+    tot_colors = std::max(tot_colors, c);
+    if constexpr (single_word_dim<dim>) open &= ~(uint64_t{1} << v);
+    g.for_each_neighbour(v, [&](const unsigned int u) {
+        if (uint64_t* f = forbidden_colors(u); color[u] == 0 && !test_bit(f, c)) {
+            set_bit(f, c);
+            trail.push_back(u);
+        }
+    });
+}
+
+template<unsigned int dim>
+void dfs_engine<dim>::undo(const frame& f, const unsigned int depth) {
+    while (trail.size() > trail_marks[depth]) {
+        clear_bit(forbidden_colors(trail.back()), f.color);
+        trail.pop_back();
+    }
+    color[f.node] = 0;
+    tot_colors = f.tot_colors;
+    if constexpr (single_word_dim<dim>) open |= uint64_t{1} << f.node;
+}
+
+template<unsigned int dim>
+unsigned int dfs_engine<dim>::next_color(const unsigned int v, const unsigned int after, const unsigned int max_color) {
+    const uint64_t* mask = forbidden_colors(v);
+    for (unsigned int c = after + 1; c <= max_color;) {
+        const uint64_t feasible = ~mask[c / 64] >> (c % 64);
+        if (feasible != 0) {
+            c += std::countr_zero(feasible);
+            return c <= max_color ? c : 0;
+        }
+        c = (c / 64 + 1) * 64;
+    }
+    return 0;
+}
+
+template<unsigned int dim>
+void dfs_engine<dim>::visited(const unsigned int depth) {
+    // the clock is only read every 4096 nodes
+    if (!checkpoint_path.empty() && tot_nodes_explored % 4096 == 0 &&
+        std::chrono::steady_clock::now() >= next_checkpoint) {
+        save_checkpoint(depth, false);
+        next_checkpoint = std::chrono::steady_clock::now() + checkpoint_interval();
+    }
+}
+
+template<unsigned int dim>
+void dfs_engine<dim>::out_of_budget(const unsigned int depth) {
+    if (!checkpoint_path.empty()) save_checkpoint(depth, false);
+}
+
+template<unsigned int dim>
+std::chrono::steady_clock::duration dfs_engine<dim>::checkpoint_interval() const {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(checkpoint_period));
+}
+
+template<unsigned int dim>
+void dfs_engine<dim>::run() {
+    // a resumed search may be over
+    if (this->settled() || finished) return;
+
+    // symmetry breaking: the root clique starts with colors 1, 2, ... and is never undone
+    const unsigned int free_nodes = this->color_root(ctx.root_clique);
+    trail.clear();
+    if (free_nodes == 0) return;
+
+    unsigned int depth = 0;
+    frames[0] = frame{select_next(g.size()), 0, 0};
+
+    if (!replay.empty()) {
+        // recolor the saved path: the search goes on below its last node, or with the next color of a complete one
+        if (replay.size() > free_nodes) {
+            throw std::runtime_error("Error: Checkpoint does not match the graph or the symmetry breaking");
+        }
+        for (unsigned int k = 0; k < replay.size(); ++k) {
+            const auto [node, c] = replay[k];
+            if (k > 0) frames[k] = frame{select_next(frames[k - 1].node), 0, 0};
+            if (node != frames[k].node || c == 0 || c > tot_colors + 1 || test_bit(forbidden_colors(node), c)) {
+                throw std::runtime_error("Error: Checkpoint does not match the search settings");
+            }
+            frames[k] = frame{node, c, tot_colors};
+            assign(node, c, k);
+        }
+        depth = static_cast<unsigned int>(replay.size());
+        if (depth == free_nodes) --depth;
+        else frames[depth] = frame{select_next(frames[depth - 1].node), 0, 0};
+        replay.clear();
+    }
+
+    next_checkpoint = std::chrono::steady_clock::now() + checkpoint_interval();
+    const bool stopped = this->search(depth, free_nodes);
+
+    // exhausted or optimal: a resume only has the result left to report
+    if (!checkpoint_path.empty() && !stopped) save_checkpoint(0, true);
+}
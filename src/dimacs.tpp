@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+inline mapped_file::mapped_file(const std::string& file_path) {
+    const int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Error: Unable to open file " + file_path);
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Error: Unable to open file " + file_path);
+    }
+
+    size = static_cast<std::size_t>(st.st_size);
+    if (size > 0) {
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Error: Unable to map file " + file_path);
+        }
+        // the file is scanned once, front to back
+        ::madvise(p, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(p);
+    }
+    ::close(fd);
+}
+
+inline mapped_file::~mapped_file() {
+    if (data) ::munmap(const_cast<char*>(data), size);
+}
+
+inline dimacs_reader::dimacs_reader(const std::string& file_path) : file_path(file_path), file(file_path) {
+    for (const char* p = file.data; p < end(); p = next_line(p)) {
+        if (*p == 'e') {
+            throw std::runtime_error("Error: Edge before the \"p edge\" line in file " + file_path);
+        }
+        if (*p != 'p') continue;
+
+        const char* q = p + 1;
+        while (q < end() && (*q == ' ' || *q == '\t')) ++q;
+        const char* format = q;
+        while (q < end() && *q != ' ' && *q != '\t' && *q != '\n' && *q != '\r') ++q;
+        const auto len = static_cast<std::size_t>(q - format);
+        if (!((len == 4 && std::memcmp(format, "edge", 4) == 0) || (len == 3 && std::memcmp(format, "col", 3) == 0))) {
+            throw std::runtime_error("Error: Unsupported format in file " + file_path);
+        }
+
+        nodes = static_cast<unsigned int>(parse_uint(q));
+        edges = parse_uint(q);
+        body = next_line(q);
+        return;
+    }
+    throw std::runtime_error("Error: Missing \"p edge\" line in file " + file_path);
+}
+
+inline const char* dimacs_reader::end() const {
+    return file.data + file.size;
+}
+
+inline unsigned long int dimacs_reader::parse_uint(const char*& p) const {
+    while (p < end() && (*p == ' ' || *p == '\t')) ++p;
+    if (p == end() || *p < '0' || *p > '9') {
+        throw std::runtime_error("Error: Expected a number in file " + file_path);
+    }
+    unsigned long int x = 0;
+    for (; p < end() && *p >= '0' && *p <= '9'; ++p)
+        x = x * 10 + static_cast<unsigned long int>(*p - '0');
+    return x;
+}
+
+inline const char* dimacs_reader::next_line(const char* p) const {
+    const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end() - p));
+    return nl ? static_cast<const char*>(nl) + 1 : end();
+}
+
+template<typename F>
+void dimacs_reader::for_each_edge(F&& f) {
+    for (const char* p = body; p < end(); p = next_line(p)) {
+        if (*p != 'e') continue;
+        const char* q = p + 1;
+        const unsigned long int u = parse_uint(q);
+        const unsigned long int v = parse_uint(q);
+        if (u == 0 || v == 0 || u > nodes || v > nodes) {
+            throw std::runtime_error("Error: Edge (" + std::to_string(u) + ", " + std::to_string(v) +
+                                     ") out of range in file " + file_path);
+        }
+        f(static_cast<unsigned int>(u - 1), static_cast<unsigned int>(v - 1));
+    }
+}
+
+inline unsigned int dimacs_nodes(const std::string& file_path) {
+    return dimacs_reader(file_path).nodes;
+}
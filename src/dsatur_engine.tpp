@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+
+#include "../include/clique.h"
+#include "../include/simd.h"
+
+template<unsigned int dim>
+dsatur_engine<dim>::dsatur_engine(context<dim>& ctx) : base(ctx) {
+    const unsigned int n = g.size();
+    open.assign(words(), 0);
+    for (unsigned int i = 0; i < n; ++i)
+        set_bit(open.data(), i);
+    every.assign(words(), ~uint64_t{0});
+    adjacent.assign(std::size_t{ctx.max_colors + 2} * words(), 0);
+    saturation.assign(n, 0);
+    // one slot per depth, and the last one for the root clique
+    if (g.sparse()) {
+        trail_marks.resize(n + 1);
+    } else {
+        fresh.assign(std::size_t{n + 1} * words(), 0);
+    }
+    ties.assign(words(), 0);
+}
+
+template<unsigned int dim>
+unsigned int dsatur_engine<dim>::words() const {
+    return g.words();
+}
+
+template<unsigned int dim>
+bool dsatur_engine<dim>::is_free(const unsigned int v, const unsigned int c) const {
+    return !test_bit(adjacent.data() + std::size_t{c} * words(), v);
+}
+
+template<unsigned int dim>
+unsigned int dsatur_engine<dim>::next_color(const unsigned int v, const unsigned int after,
+                                            const unsigned int max_color) const {
+    for (unsigned int c = after + 1; c <= max_color; ++c)
+        if (is_free(v, c)) return c;
+    return 0;
+}
+
+template<unsigned int dim>
+void dsatur_engine<dim>::assign(const unsigned int v, const unsigned int c, const unsigned int depth) {
+    color[v] = c;
+    tot_colors = std::max(tot_colors, c);
+    clear_bit(open.data(), v);
+    uint64_t* cls = adjacent.data() + std::size_t{c} * words();
+
+    if (g.sparse()) {
+        // the uncolored neighbours of v not yet in class c join it and gain one of saturation, the trail keeps them
+        trail_marks[depth] = trail.size();
+        g.for_each_neighbour(v, [&](const unsigned int u) {
+            if (!test_bit(open.data(), u) || test_bit(cls, u)) return;
+            set_bit(cls, u);
+            ++saturation[u];
+            trail.push_back(u);
+        });
+        return;
+    }
+
+    // the neighbours of v join class c, added records the ones not in it yet (every node counts as open, so that
+    // undo() takes out each bit set here) and the uncolored ones among them gain one of saturation
+    uint64_t* added = fresh.data() + std::size_t{depth} * words();
+    row_saturate(g.row(v), cls, every.data(), added, words());
+    for_each_bit(added, words(), [&](const unsigned int u) {
+        if (test_bit(open.data(), u)) ++saturation[u];
+    });
+}
+
+template<unsigned int dim>
+void dsatur_engine<dim>::undo(const frame& f, const unsigned int depth) {
+    uint64_t* cls = adjacent.data() + std::size_t{f.color} * words();
+    if (g.sparse()) {
+        for (; trail.size() > trail_marks[depth]; trail.pop_back()) {
+            clear_bit(cls, trail.back());
+            --saturation[trail.back()];
+        }
+    } else {
+        const uint64_t* added = fresh.data() + std::size_t{depth} * words();
+        for (unsigned int k = 0; k < words(); ++k)
+            cls[k] &= ~added[k];
+        // the nodes open now are the ones open right after assign()
+        for_each_bit(added, words(), [&](const unsigned int u) {
+            if (test_bit(open.data(), u)) --saturation[u];
+        });
+    }
+
+    set_bit(open.data(), f.node);
+    color[f.node] = 0;
+    tot_colors = f.tot_colors;
+}
+
+template<unsigned int dim>
+unsigned int dsatur_engine<dim>::select_next(unsigned int) {
+    // uncolored nodes of highest saturation
+    unsigned int top = 0, tied = 0, pick = g.size();
+    for_each_bit(open.data(), words(), [&](const unsigned int v) {
+        if (pick == g.size() || saturation[v] > top) {
+            std::fill(ties.begin(), ties.end(), 0);
+            top = saturation[v];
+            tied = 0;
+        }
+        if (saturation[v] == top) {
+            set_bit(ties.data(), v);
+            pick = v;
+            ++tied;
+        }
+    });
+    if (tied <= 1) return pick;
+
+    // PASS: the tied node whose free colors are also free for most of its tied neighbours, as coloring it removes
+    // the most options from the nodes branched on next. Then the highest degree among the uncolored nodes
+    unsigned int best_score = 0, best_degree = 0;
+    pick = g.size();
+    for_each_bit(ties.data(), words(), [&](const unsigned int v) {
+        unsigned int score = 0;
+        for (unsigned int c = 1; c <= tot_colors; ++c) {
+            if (!is_free(v, c)) continue;
+            const uint64_t* cls = adjacent.data() + std::size_t{c} * words();
+            if (g.sparse()) {
+                g.for_each_neighbour(v, [&](const unsigned int u) {
+                    score += test_bit(ties.data(), u) && !test_bit(cls, u);
+                });
+                continue;
+            }
+            const uint64_t* row = g.row(v);
+            for (unsigned int k = 0; k < words(); ++k)
+                score += std::popcount(row[k] & ties[k] & ~cls[k]);
+        }
+        if (pick != g.size() && score < best_score) return;
+        const unsigned int degree = g.count_neighbours_in(v, open.data());
+        if (pick == g.size() || score > best_score || degree > best_degree) {
+            pick = v;
+            best_score = score;
+            best_degree = degree;
+        }
+    });
+    return pick;
+}
+
+template<unsigned int dim>
+void dsatur_engine<dim>::run() {
+    if (this->settled()) return;
+
+    // the root clique starts with colors 1, 2, ... and is never undone
+    const std::vector<unsigned int> clique = ctx.root_clique.empty() ? greedy_clique(g) : ctx.root_clique;
+    ctx.colors_lb = std::max<unsigned int>(ctx.colors_lb, clique.size());
+    const unsigned int free_nodes = this->color_root(clique);
+    if (free_nodes == 0) return;
+
+    frames[0] = frame{select_next(g.size()), 0, 0};
+    this->search(0, free_nodes);
+}
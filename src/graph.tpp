@@ -1,55 +1,446 @@
 #pragma once
-template <unsigned int dim>
-graph<dim>::graph(const std::string& file_path) : m{} {
-    std::ifstream file(file_path);
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+
+template<typename T, unsigned int dim>
+storage_t<T, dim> make_storage(const unsigned int n) {
+    storage_t<T, dim> s{};
+    if constexpr (dim == dynamic_dim) s.assign(n, T{});
+    return s;
+}
+
+inline uint64_t stream_random(const uint64_t stream, const uint64_t counter) {
+    uint64_t z = stream * 0x9e3779b97f4a7c15ULL + (counter + 1) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+inline bool is_binary_graph(const std::string& file_path) {
+    char magic[sizeof(binary_magic)] = {};
+    std::ifstream file(file_path, std::ios::binary);
     if (!file) {
         throw std::runtime_error("Error: Unable to open file " + file_path);
     }
+    file.read(magic, sizeof(magic));
+    return file.gcount() == sizeof(magic) && std::memcmp(magic, binary_magic, sizeof(magic)) == 0;
+}
 
-    std::string line;
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string type;
-        iss >> type;
-
-        if (type == "c") {
-            continue;
-        } else if (type == "p") {
-            std::string format;
-            unsigned int nodes, edges;
-            iss >> format >> nodes >> edges;
-            if (format != "edge" || nodes != dim) {
-                throw std::runtime_error("Error: Dimension mismatch in file");
-            }
-        } else if (type == "e") {
-            unsigned int u, v;
-            if (iss >> u >> v) {
-                --u;
-                --v;
-                m[u][v] = true;
-                m[v][u] = true;
+inline uint64_t binary_file_bytes(const binary_header& header) {
+    const uint64_t nodes = header.nodes;
+    if (header.words == 0)
+        return sizeof(header) + (nodes + 1) * sizeof(uint64_t) + 2 * header.edges * sizeof(unsigned int);
+    if (header.words != bit_words(header.nodes)) return 0;
+    return sizeof(header) + nodes * header.words * sizeof(uint64_t);
+}
+
+inline unsigned int graph_nodes(const std::string& file_path) {
+    if (!is_binary_graph(file_path)) return dimacs_nodes(file_path);
+
+    binary_header header{};
+    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+    const auto file_bytes = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    // the edge count is only bounded by the file size, so check it before it sizes anything
+    if (file.gcount() != sizeof(header) || header.edges > file_bytes || binary_file_bytes(header) != file_bytes) {
+        throw std::runtime_error("Error: Corrupted binary graph file " + file_path);
+    }
+    return header.nodes;
+}
+
+template <unsigned int dim>
+graph<dim>::graph(const std::string& file_path) : m{} {
+    if (is_binary_graph(file_path)) {
+        load_binary(file_path);
+        return;
+    }
+
+    dimacs_reader reader(file_path);
+    const double pairs = 0.5 * reader.nodes * (reader.nodes - 1.0);
+    if (dim == dynamic_dim && reader.nodes >= sparse_min_nodes && reader.edges < sparse_max_density * pairs) {
+        load_lists(reader, file_path);
+        return;
+    }
+
+    resize(reader.nodes);
+    reader.for_each_edge([&](const unsigned int u, const unsigned int v) {
+        if (u == v) {
+            throw std::runtime_error("Error: Self loop on node " + std::to_string(u + 1) + " in file " + file_path);
+        }
+        add_edge(u, v);
+    });
+}
+
+template <unsigned int dim>
+graph<dim>::graph(const double density, const unsigned int nodes)
+    : graph(density, nodes, (uint64_t{std::random_device{}()} << 32) | std::random_device{}()) {}
+
+template <unsigned int dim>
+graph<dim>::graph(const double density, const unsigned int nodes, const uint64_t seed, const unsigned int threads)
+    : m{} {
+    const double pairs = 0.5 * nodes * (nodes - 1.0);
+    const bool lists = dim == dynamic_dim && nodes >= sparse_min_nodes && density < sparse_max_density;
+    resize(nodes, lists);
+    if (density <= 0 || nodes < 2) return;
+
+    // the stream of each row is keyed by the seed, so every row can be drawn on its own
+    const uint64_t key = stream_random(seed, 0);
+
+    // calls f(j) for the neighbours j > i of node i: the gap to the next edge is geometric, which skips the absent
+    // pairs without drawing them (density 1 takes every pair)
+    const double log_q = std::log1p(-std::min(density, 1.0));
+    const auto for_each_upper = [&](const unsigned int i, auto&& f) {
+        uint64_t counter = 0;
+        for (double j = i; ;) {
+            if (density < 1) {
+                // uniform in (0, 1]
+                const double u = static_cast<double>((stream_random(key + i, counter++) >> 11) + 1) * 0x1p-53;
+                j += std::floor(std::log(u) / log_q);
             }
+            if (++j >= size()) break;
+            f(static_cast<unsigned int>(j));
         }
+    };
+
+    // rows are dealt round-robin, which balances the shrinking upper triangle over the threads
+    const unsigned int workers = std::max(1u, std::min<unsigned int>(threads, static_cast<unsigned int>(pairs / 65536) + 1));
+    const auto run = [&](auto&& row_task) {
+        std::vector<std::thread> pool;
+        for (unsigned int t = 1; t < workers; ++t)
+            pool.emplace_back([&, t] { for (unsigned int i = t; i < size(); i += workers) row_task(i); });
+        for (unsigned int i = 0; i < size(); i += workers) row_task(i);
+        for (auto& th : pool) th.join();
+    };
+
+    if (!sparse()) {
+        // row j is shared by every thread drawing an edge (i, j) with i < j: the mirrored bits are set atomically
+        run([&](const unsigned int i) {
+            uint64_t* r = m.data() + static_cast<std::size_t>(i) * words();
+            for_each_upper(i, [&](const unsigned int j) {
+                std::atomic_ref<uint64_t>(r[j / 64]).fetch_or(uint64_t{1} << (j % 64), std::memory_order_relaxed);
+                std::atomic_ref<uint64_t>(m[static_cast<std::size_t>(j) * words() + i / 64])
+                    .fetch_or(uint64_t{1} << (i % 64), std::memory_order_relaxed);
+            });
+        });
+        return;
+    }
+
+    // lists: the upper neighbours of each row are drawn in parallel, then laid out with the lower ones first, so
+    // every list comes out sorted
+    std::vector<std::vector<unsigned int>> upper(size());
+    run([&](const unsigned int i) { for_each_upper(i, [&](const unsigned int j) { upper[i].push_back(j); }); });
+
+    std::vector<std::size_t> lower(size(), 0);
+    for (unsigned int i = 0; i < size(); ++i)
+        for (const unsigned int j : upper[i]) ++lower[j];
+    for (unsigned int i = 0; i < size(); ++i)
+        offsets[i + 1] = offsets[i] + lower[i] + upper[i].size();
+
+    adj.resize(offsets[size()]);
+    std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+    for (unsigned int i = 0; i < size(); ++i) {
+        for (const unsigned int j : upper[i]) adj[pos[j]++] = i;
+        std::copy(upper[i].begin(), upper[i].end(), adj.begin() + static_cast<std::ptrdiff_t>(offsets[i] + lower[i]));
+        std::vector<unsigned int>().swap(upper[i]);
     }
 }
 
 template <unsigned int dim>
-graph<dim>::graph(const double density) : m{} {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::bernoulli_distribution dist(density); // Probability of an edge
+template <unsigned int other>
+graph<dim>::graph(const graph<other>& g, const std::vector<unsigned int>& nodes) : m{} {
+    resize(static_cast<unsigned int>(nodes.size()), g.sparse());
 
-    for (unsigned int i = 0; i < dim; ++i) {
-        for (unsigned int j = i + 1; j < dim; ++j) { // Fill only upper triangle
-            bool edge = dist(gen);
-            m[i][j] = edge;
-            m[j][i] = edge; // Symmetric for undirected graph
+    // position of each node of g in the subgraph, -1 if it is not part of it
+    std::vector<unsigned int> index(g.size(), -1);
+    for (unsigned int i = 0; i < size(); ++i)
+        index[nodes[i]] = i;
+
+    for (unsigned int i = 0; i < size(); ++i) {
+        const std::size_t first = adj.size();
+        g.for_each_neighbour(nodes[i], [&](const unsigned int j) {
+            if (index[j] == static_cast<unsigned int>(-1)) return;
+            if (sparse()) adj.push_back(index[j]);
+            else set_bit(m.data() + static_cast<std::size_t>(i) * words(), index[j]);
+        });
+        if (sparse()) {
+            std::sort(adj.begin() + static_cast<std::ptrdiff_t>(first), adj.end());
+            offsets[i + 1] = adj.size();
         }
-        m[i][i] = false; // No self-loops
     }
 }
 
+template<unsigned int dim>
+void graph<dim>::resize(const unsigned int nodes, const bool lists) {
+    if constexpr (dim == dynamic_dim) {
+        n = nodes;
+        w = bit_words(nodes);
+        csr = lists;
+        if (csr) {
+            m.clear();
+            offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+            adj.clear();
+        } else {
+            m.assign(static_cast<std::size_t>(n) * w, 0);
+        }
+    } else if (nodes != dim) {
+        throw std::runtime_error("Error: Dimension mismatch in file");
+    }
+}
+
+template<unsigned int dim>
+void graph<dim>::load_lists(dimacs_reader& reader, const std::string& file_path) {
+    resize(reader.nodes, true);
+
+    // first pass: degrees (duplicates and symmetric entries included), turned into the start of each list
+    reader.for_each_edge([&](const unsigned int u, const unsigned int v) {
+        if (u == v) {
+            throw std::runtime_error("Error: Self loop on node " + std::to_string(u + 1) + " in file " + file_path);
+        }
+        ++offsets[u + 1];
+        ++offsets[v + 1];
+    });
+    for (unsigned int i = 0; i < n; ++i)
+        offsets[i + 1] += offsets[i];
+
+    // second pass: scatter the edges, pos[i] is the next free slot of node i
+    adj.resize(offsets[n]);
+    std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+    reader.for_each_edge([&](const unsigned int u, const unsigned int v) {
+        adj[pos[u]++] = v;
+        adj[pos[v]++] = u;
+    });
+
+    // sort every list and drop the duplicates, compacting the lists in place
+    std::size_t out = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        const auto first = adj.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+        const auto last = adj.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1]);
+        std::sort(first, last);
+        const auto unique_end = std::unique(first, last);
+        offsets[i] = out;
+        out = static_cast<std::size_t>(std::copy(first, unique_end, adj.begin() + static_cast<std::ptrdiff_t>(out)) -
+                                       adj.begin());
+    }
+    offsets[n] = out;
+    adj.resize(out);
+    adj.shrink_to_fit();
+}
+
+template<unsigned int dim>
+void graph<dim>::load_binary(const std::string& file_path) {
+    const int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Error: Unable to open file " + file_path);
+    }
+
+    // reads exactly len bytes, false on a short file
+    const auto read_all = [fd](void* dst, const std::size_t len) {
+        auto* p = static_cast<char*>(dst);
+        for (std::size_t done = 0; done < len;) {
+            const ssize_t r = ::read(fd, p + done, len - done);
+            if (r <= 0) return false;
+            done += static_cast<std::size_t>(r);
+        }
+        return true;
+    };
+
+    struct stat st{};
+    binary_header header{};
+    bool ok = ::fstat(fd, &st) == 0 && read_all(&header, sizeof(header)) &&
+              header.edges <= static_cast<uint64_t>(st.st_size) &&
+              binary_file_bytes(header) == static_cast<uint64_t>(st.st_size);
+    if (ok && header.words == 0 && dim == dynamic_dim) {
+        // adjacency lists, the offsets are stored as 64-bit integers whatever the size of std::size_t
+        resize(header.nodes, true);
+        std::vector<uint64_t> raw(offsets.size());
+        ok = read_all(raw.data(), raw.size() * sizeof(uint64_t)) && raw[0] == 0 && raw.back() == 2 * header.edges;
+        for (std::size_t i = 0; ok && i < raw.size(); ++i) {
+            ok = i == 0 || raw[i] >= raw[i - 1];
+            offsets[i] = static_cast<std::size_t>(raw[i]);
+        }
+        if (ok) {
+            adj.resize(offsets.back());
+            ok = read_all(adj.data(), adj.size() * sizeof(unsigned int));
+        }
+        for (std::size_t k = 0; ok && k < adj.size(); ++k)
+            ok = adj[k] < n;
+    } else if (ok) {
+        ok = header.words == bit_words(header.nodes);
+        if (ok) {
+            resize(header.nodes);
+            ok = read_all(m.data(), m.size() * sizeof(uint64_t));
+        }
+        // bits past the last node would be read back as neighbours out of range
+        const uint64_t padding = size() % 64 == 0 ? 0 : ~uint64_t{0} << (size() % 64);
+        for (unsigned int i = 0; ok && i < size(); ++i) {
+            const uint64_t* r = m.data() + static_cast<std::size_t>(i) * words();
+            ok = (r[words() - 1] & padding) == 0 && !test_bit(r, i);
+            for (unsigned int k = 0; ok && k < words(); ++k)
+                for (uint64_t bits = r[k]; ok && bits != 0; bits &= bits - 1)
+                    ok = (*this)(64 * k + static_cast<unsigned int>(std::countr_zero(bits)), i);
+        }
+    }
+    ::close(fd);
+    if (!ok) {
+        throw std::runtime_error("Error: Corrupted binary graph file " + file_path);
+    }
+}
+
+template<unsigned int dim>
+void graph<dim>::save(const std::string& file_path) const {
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Error: Unable to write file " + file_path);
+    }
+
+    binary_header header{};
+    std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+    header.nodes = size();
+    header.words = sparse() ? 0 : words();
+    header.edges = edges();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (sparse()) {
+        const std::vector<uint64_t> raw(offsets.begin(), offsets.end());
+        file.write(reinterpret_cast<const char*>(raw.data()), static_cast<std::streamsize>(raw.size() * sizeof(uint64_t)));
+        file.write(reinterpret_cast<const char*>(adj.data()), static_cast<std::streamsize>(adj.size() * sizeof(unsigned int)));
+    } else {
+        file.write(reinterpret_cast<const char*>(m.data()), static_cast<std::streamsize>(m.size() * sizeof(uint64_t)));
+    }
+    if (!file) {
+        throw std::runtime_error("Error: Unable to write file " + file_path);
+    }
+}
+
+template<unsigned int dim>
+unsigned long int graph<dim>::edges() const {
+    if (sparse()) return adj.size() / 2;
+    unsigned long int e = 0;
+    for (unsigned int i = 0; i < size(); ++i)
+        e += degree(i);
+    return e / 2;
+}
+
+template<unsigned int dim>
+unsigned int graph<dim>::size() const {
+    if constexpr (dim == dynamic_dim) return n;
+    else return dim;
+}
+
+template<unsigned int dim>
+unsigned int graph<dim>::words() const {
+    if constexpr (dim == dynamic_dim) return w;
+    else return bit_words(dim);
+}
+
+template<unsigned int dim>
+bool graph<dim>::sparse() const {
+    if constexpr (dim == dynamic_dim) return csr;
+    else return false;
+}
+
 template<unsigned int dim>
 bool graph<dim>::operator()(unsigned int i, unsigned int j) const {
-    return m[i][j];
+    if (sparse()) {
+        return std::binary_search(adj.begin() + static_cast<std::ptrdiff_t>(offsets[i]),
+                                  adj.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1]), j);
+    }
+    return test_bit(row(i), j);
+}
+
+template<unsigned int dim>
+const uint64_t* graph<dim>::row(unsigned int i) const {
+    assert(!sparse() && "A sparse graph has no adjacency rows!");
+    return m.data() + static_cast<std::size_t>(i) * words();
+}
+
+template<unsigned int dim>
+template<typename F>
+void graph<dim>::for_each_neighbour(const unsigned int i, F&& f) const {
+    if (sparse()) {
+        for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+            f(adj[k]);
+        return;
+    }
+    for_each_bit(row(i), words(), f);
+}
+
+template<unsigned int dim>
+unsigned int graph<dim>::degree(unsigned int i) const {
+    if (sparse()) return static_cast<unsigned int>(offsets[i + 1] - offsets[i]);
+    return count_bits(row(i), words());
+}
+
+template<unsigned int dim>
+unsigned int graph<dim>::max_degree() const {
+    unsigned int d = 0;
+    for (unsigned int i = 0; i < size(); ++i)
+        d = std::max(d, degree(i));
+    return d;
+}
+
+template<unsigned int dim>
+unsigned int graph<dim>::count_neighbours_in(unsigned int i, const uint64_t* mask) const {
+    if (sparse()) {
+        unsigned int d = 0;
+        for_each_neighbour(i, [&](const unsigned int j) { d += test_bit(mask, j); });
+        return d;
+    }
+    const uint64_t* r = row(i);
+    unsigned int d = 0;
+    for (unsigned int k = 0; k < words(); ++k)
+        d += std::popcount(r[k] & mask[k]);
+    return d;
+}
+
+template<unsigned int dim>
+void graph<dim>::intersect_neighbours(const unsigned int i, uint64_t* set) const {
+    if (sparse()) {
+        // the set is usually small next to the matrix row: look its nodes up in the list of i
+        for_each_bit(set, words(), [&](const unsigned int j) {
+            if (!(*this)(i, j)) clear_bit(set, j);
+        });
+        return;
+    }
+    const uint64_t* r = row(i);
+    for (unsigned int k = 0; k < words(); ++k)
+        set[k] &= r[k];
+}
+
+template<unsigned int dim>
+void graph<dim>::add_edge(unsigned int i, unsigned int j) {
+    if (sparse()) {
+        if ((*this)(i, j)) return;
+        // insert each end at its sorted position, shifting the lists of the following nodes by one
+        for (const auto& [a, b] : {std::pair{i, j}, std::pair{j, i}}) {
+            const auto first = adj.begin() + static_cast<std::ptrdiff_t>(offsets[a]);
+            const auto last = adj.begin() + static_cast<std::ptrdiff_t>(offsets[a + 1]);
+            adj.insert(std::lower_bound(first, last, b), b);
+            for (unsigned int k = a + 1; k <= n; ++k)
+                ++offsets[k];
+        }
+        return;
+    }
+    set_bit(m.data() + static_cast<std::size_t>(i) * words(), j);
+    set_bit(m.data() + static_cast<std::size_t>(j) * words(), i);
+}
+
+template<unsigned int dim>
+void graph<dim>::remove_edge(unsigned int i, unsigned int j) {
+    if (sparse()) {
+        if (!(*this)(i, j)) return;
+        for (const auto& [a, b] : {std::pair{i, j}, std::pair{j, i}}) {
+            const auto first = adj.begin() + static_cast<std::ptrdiff_t>(offsets[a]);
+            const auto last = adj.begin() + static_cast<std::ptrdiff_t>(offsets[a + 1]);
+            adj.erase(std::lower_bound(first, last, b));
+            for (unsigned int k = a + 1; k <= n; ++k)
+                --offsets[k];
+        }
+        return;
+    }
+    clear_bit(m.data() + static_cast<std::size_t>(i) * words(), j);
+    clear_bit(m.data() + static_cast<std::size_t>(j) * words(), i);
 }
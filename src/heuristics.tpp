@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+
+#include "../include/ordering.h"
+#include "../include/simd.h"
+
+inline warm_start parse_warm_start(const std::string& name) {
+    if (name == "none") return warm_start::none;
+    if (name == "greedy") return warm_start::greedy;
+    if (name == "dsatur") return warm_start::dsatur;
+    if (name == "tabucol") return warm_start::tabucol;
+    throw std::runtime_error("Error: Unknown warm start heuristic " + name);
+}
+
+template<unsigned int dim>
+unsigned int colors_used(const storage_t<unsigned int, dim>& coloring) {
+    unsigned int k = 0;
+    for (const unsigned int c : coloring)
+        k = std::max(k, c);
+    return k;
+}
+
+template<unsigned int dim>
+storage_t<unsigned int, dim> greedy_coloring(const graph<dim>& g, const std::vector<unsigned int>& order) {
+    auto color = make_storage<unsigned int, dim>(g.size());
+
+    // colors of the neighbours of the current node, a node has at most size() neighbours
+    std::vector<bool> used(g.size() + 2, false);
+    for (const unsigned int v : order) {
+        g.for_each_neighbour(v, [&](const unsigned int u) { used[color[u]] = true; });
+        unsigned int c = 1;
+        while (used[c]) ++c;
+        color[v] = c;
+        g.for_each_neighbour(v, [&](const unsigned int u) { used[color[u]] = false; });
+    }
+    return color;
+}
+
+template<unsigned int dim>
+storage_t<unsigned int, dim> dsatur_coloring(const graph<dim>& g) {
+    const unsigned int n = g.size();
+    auto color = make_storage<unsigned int, dim>(n);
+
+    // degrees break the ties between equal saturations
+    unsigned int max_degree = 0;
+    std::vector<unsigned int> degree(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        degree[i] = g.degree(i);
+        max_degree = std::max(max_degree, degree[i]);
+    }
+    std::vector<unsigned int> saturation(n, 0);
+
+    // uncolored nodes, the one with highest (saturation, degree) first
+    std::set<std::tuple<unsigned int, unsigned int, unsigned int>> queue;
+    for (unsigned int i = 0; i < n; ++i)
+        queue.emplace(0, degree[i], n - 1 - i);
+
+    const auto raise = [&](const unsigned int u) {
+        queue.erase({saturation[u], degree[u], n - 1 - u});
+        queue.emplace(++saturation[u], degree[u], n - 1 - u);
+    };
+
+    if (!g.sparse()) {
+        // transposed layout: adjacent[c] is the set of nodes with a neighbour of color c, so coloring a node updates
+        // the saturations with word operations over its row
+        const unsigned int words = g.words();
+        std::vector<uint64_t> open(words, 0), fresh(words), adjacent(words);
+        for (unsigned int i = 0; i < n; ++i)
+            set_bit(open.data(), i);
+
+        unsigned int colors = 0;
+        while (!queue.empty()) {
+            const unsigned int v = n - 1 - std::get<2>(*queue.rbegin());
+            queue.erase(std::prev(queue.end()));
+            clear_bit(open.data(), v);
+
+            unsigned int c = 1;
+            while (c <= colors && test_bit(adjacent.data() + std::size_t{c} * words, v)) ++c;
+            if (c > colors) {
+                colors = c;
+                adjacent.resize(std::size_t{c + 1} * words, 0);
+            }
+            color[v] = c;
+
+            if (row_saturate(g.row(v), adjacent.data() + std::size_t{c} * words, open.data(), fresh.data(), words))
+                for_each_bit(fresh.data(), words, raise);
+        }
+        return color;
+    }
+
+    // forbidden colors of each node: no more than max degree + 1 colors are ever used
+    const unsigned int cw = bit_words(max_degree + 2);
+    std::vector<uint64_t> forbidden(static_cast<std::size_t>(n) * cw, 0);
+    while (!queue.empty()) {
+        const unsigned int v = n - 1 - std::get<2>(*queue.rbegin());
+        queue.erase(std::prev(queue.end()));
+
+        uint64_t* f = forbidden.data() + static_cast<std::size_t>(v) * cw;
+        unsigned int c = 1;
+        while (test_bit(f, c)) ++c;
+        color[v] = c;
+
+        g.for_each_neighbour(v, [&](const unsigned int u) {
+            uint64_t* fu = forbidden.data() + static_cast<std::size_t>(u) * cw;
+            if (color[u] != 0 || test_bit(fu, c)) return;
+            set_bit(fu, c);
+            raise(u);
+        });
+    }
+    return color;
+}
+
+template<unsigned int dim>
+storage_t<unsigned int, dim> tabucol(const graph<dim>& g, const storage_t<unsigned int, dim>& initial,
+                                     const unsigned int min_colors, const double time_limit_s,
+                                     const search_budget* budget, const uint64_t seed) {
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + std::chrono::duration<double>(time_limit_s);
+    const auto out_of_time = [&] { return clock::now() >= deadline || (budget && budget->stopped()); };
+
+    const unsigned int n = g.size();
+    storage_t<unsigned int, dim> best = initial;
+    unsigned int k = colors_used<dim>(initial);
+
+    // the conflict table takes size() * colors counters: skip graphs where it would not fit comfortably
+    if (n == 0 || static_cast<std::size_t>(n) * k > (std::size_t{1} << 26)) return best;
+
+    std::mt19937_64 gen(seed);
+    std::vector<unsigned int> col(n);
+    std::vector<int> gamma;          // gamma[v * k + c]: neighbours of v with color c
+    std::vector<unsigned long> tabu; // tabu[v * k + c]: iteration until which moving v to c is forbidden
+    std::vector<unsigned int> conflicting;
+
+    // colors are 0-based inside the search
+    for (unsigned int i = 0; i < n; ++i)
+        col[i] = initial[i] - 1;
+
+    unsigned long iter = 0;
+    while (k > std::max(min_colors, 1u) && !out_of_time()) {
+        // drop the highest color, moving its nodes to random colors
+        --k;
+        std::uniform_int_distribution<unsigned int> random_color(0, k - 1);
+        for (unsigned int i = 0; i < n; ++i)
+            if (col[i] >= k) col[i] = random_color(gen);
+
+        gamma.assign(static_cast<std::size_t>(n) * k, 0);
+        tabu.assign(static_cast<std::size_t>(n) * k, 0);
+        long conflicts = 0;
+        for (unsigned int i = 0; i < n; ++i)
+            g.for_each_neighbour(i, [&](const unsigned int j) {
+                ++gamma[static_cast<std::size_t>(i) * k + col[j]];
+                if (j > i && col[i] == col[j]) ++conflicts;
+            });
+
+        while (conflicts > 0) {
+            if ((++iter & 1023) == 0 && out_of_time()) return best;
+
+            conflicting.clear();
+            for (unsigned int i = 0; i < n; ++i)
+                if (gamma[static_cast<std::size_t>(i) * k + col[i]] > 0) conflicting.push_back(i);
+
+            // best non tabu move among the conflicting nodes, tabu moves allowed if they improve the best state
+            unsigned int move_v = n, move_c = 0, ties = 0;
+            long move_delta = 0;
+            for (const unsigned int v : conflicting) {
+                const int* gv = gamma.data() + static_cast<std::size_t>(v) * k;
+                for (unsigned int c = 0; c < k; ++c) {
+                    if (c == col[v]) continue;
+                    const long delta = gv[c] - gv[col[v]];
+                    const bool is_tabu = tabu[static_cast<std::size_t>(v) * k + c] > iter;
+                    if (is_tabu && conflicts + delta > 0) continue;
+                    if (move_v == n || delta < move_delta) {
+                        move_v = v, move_c = c, move_delta = delta, ties = 1;
+                    } else if (delta == move_delta && gen() % ++ties == 0) {
+                        move_v = v, move_c = c;
+                    }
+                }
+            }
+            if (move_v == n) continue;
+
+            const unsigned int old = col[move_v];
+            col[move_v] = move_c;
+            g.for_each_neighbour(move_v, [&](const unsigned int u) {
+                --gamma[static_cast<std::size_t>(u) * k + old];
+                ++gamma[static_cast<std::size_t>(u) * k + move_c];
+            });
+            conflicts += move_delta;
+            tabu[static_cast<std::size_t>(move_v) * k + old] =
+                iter + gen() % 10 + static_cast<unsigned long>(0.6 * static_cast<double>(conflicting.size()));
+        }
+
+        // conflict free: a valid coloring with k colors
+        for (unsigned int i = 0; i < n; ++i)
+            best[i] = col[i] + 1;
+    }
+    return best;
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "../include/clique.h"
+#include "../include/heuristics.h"
+
+template<unsigned int dim>
+incremental_coloring<dim>::incremental_coloring(graph<dim> g, const storage_t<unsigned int, dim>& coloring,
+                                                std::vector<unsigned int> clique)
+    : g(std::move(g)), coloring(coloring), colors(colors_used<dim>(coloring)), clique(std::move(clique)) {
+    if (this->coloring.size() != this->g.size()) {
+        throw std::runtime_error("Error: Coloring of " + std::to_string(this->coloring.size()) +
+                                 " nodes for a graph of " + std::to_string(this->g.size()));
+    }
+    slot.assign(this->g.size(), none);
+    original.assign(this->g.size(), 0);
+}
+
+template<unsigned int dim>
+void incremental_coloring<dim>::add_edge(const unsigned int i, const unsigned int j) {
+    if (i >= g.size() || j >= g.size() || i == j) {
+        throw std::runtime_error("Error: Invalid edge " + std::to_string(i) + " " + std::to_string(j));
+    }
+    if (g(i, j)) return;
+    g.add_edge(i, j);
+    if (coloring[i] == coloring[j]) {
+        conflicted.push_back(i);
+        conflicted.push_back(j);
+    }
+}
+
+template<unsigned int dim>
+void incremental_coloring<dim>::remove_edge(const unsigned int i, const unsigned int j) {
+    if (i >= g.size() || j >= g.size() || i == j) {
+        throw std::runtime_error("Error: Invalid edge " + std::to_string(i) + " " + std::to_string(j));
+    }
+    if (!g(i, j)) return;
+    g.remove_edge(i, j);
+    removed = true;
+    const auto in_clique = [&](const unsigned int v) {
+        return std::find(clique.begin(), clique.end(), v) != clique.end();
+    };
+    if (in_clique(i) && in_clique(j)) clique_broken = true;
+}
+
+template<unsigned int dim>
+unsigned int incremental_coloring<dim>::lower_bound() const {
+    return g.size() == 0 ? 0 : std::max<unsigned int>(clique.size(), 1);
+}
+
+template<unsigned int dim>
+bool incremental_coloring<dim>::optimal() const {
+    return colors <= lower_bound();
+}
+
+template<unsigned int dim>
+unsigned int incremental_coloring<dim>::free_color(const unsigned int v, const unsigned int limit) const {
+    // colors of the neighbours, a node has fewer neighbours than size()
+    std::vector<bool> used(limit + 1, false);
+    g.for_each_neighbour(v, [&](const unsigned int u) {
+        if (coloring[u] <= limit) used[coloring[u]] = true;
+    });
+    for (unsigned int c = 1; c <= limit; ++c)
+        if (!used[c]) return c;
+    return 0;
+}
+
+template<unsigned int dim>
+void incremental_coloring<dim>::set_color(const unsigned int v, const unsigned int c) {
+    if (original[v] == 0) {
+        original[v] = coloring[v];
+        touched.push_back(v);
+    }
+    coloring[v] = c;
+}
+
+template<unsigned int dim>
+bool incremental_coloring<dim>::in_conflict(const unsigned int v) const {
+    bool conflict = false;
+    g.for_each_neighbour(v, [&](const unsigned int u) { conflict = conflict || coloring[u] == coloring[v]; });
+    return conflict;
+}
+
+template<unsigned int dim>
+unsigned int incremental_coloring<dim>::repair(const double time_limit_s) {
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(time_limit_s));
+    const unsigned int before = colors;
+
+    // a removed edge of the clique leaves a weaker, still valid bound: look for a new clique
+    if (clique_broken) {
+        clique = greedy_clique(g);
+        clique_broken = false;
+    }
+
+    // most conflicts vanish by moving one end to a color none of its neighbours has
+    std::sort(conflicted.begin(), conflicted.end());
+    conflicted.erase(std::unique(conflicted.begin(), conflicted.end()), conflicted.end());
+    std::erase_if(conflicted, [&](const unsigned int v) {
+        if (!in_conflict(v)) return true;
+        const unsigned int c = free_color(v, colors);
+        if (c != 0) set_color(v, c);
+        return c != 0;
+    });
+
+    // the rest by the local search, over a region twice as deep after each failure
+    for (unsigned int radius = region_radius; !conflicted.empty() && clock::now() < deadline; radius *= 2)
+        if (!local_search(deadline, radius)) break;
+
+    // no coloring with the previous colors found: the nodes left in conflict take the first color free of their
+    // neighbours, new ones if needed
+    for (const unsigned int v : conflicted) {
+        if (!in_conflict(v)) continue;
+        set_color(v, free_color(v, colors + 1));
+        colors = std::max(colors, coloring[v]);
+    }
+    conflicted.clear();
+
+    // fewer edges or new colors: the coloring may shrink
+    if (removed || colors > before) compact();
+    removed = false;
+
+    recolored = 0;
+    for (const unsigned int v : touched) {
+        recolored += coloring[v] != original[v];
+        original[v] = 0;
+    }
+    touched.clear();
+    return colors;
+}
+
+template<unsigned int dim>
+bool incremental_coloring<dim>::local_search(const std::chrono::steady_clock::time_point deadline,
+                                             const unsigned int radius) {
+    // region: the conflicted nodes, then the rings of their neighbours up to radius hops
+    std::vector<unsigned int> region;
+    for (const unsigned int v : conflicted) {
+        if (slot[v] != none) continue;
+        slot[v] = region.size();
+        region.push_back(v);
+    }
+    std::size_t ring = 0;
+    for (unsigned int r = 0; r < radius && ring < region.size() && region.size() < region_cap; ++r) {
+        const std::size_t ring_end = region.size();
+        for (std::size_t i = ring; i < ring_end && region.size() < region_cap; ++i)
+            g.for_each_neighbour(region[i], [&](const unsigned int u) {
+                if (slot[u] != none || region.size() >= region_cap) return;
+                slot[u] = region.size();
+                region.push_back(u);
+            });
+        ring = ring_end;
+    }
+    // a region that could not grow any more will not do better next time
+    const bool grown = ring < region.size() && region.size() < region_cap;
+
+    const std::size_t size = region.size();
+    const unsigned int k = colors;
+    if (k > 1) {
+        // TabuCol over the region with k colors, 0-based inside the search. gamma[i * k + c]: neighbours of region[i]
+        // with color c + 1, the nodes outside of the region included
+        std::vector<int> gamma(size * k, 0);
+        std::vector<unsigned long> tabu(size * k, 0);
+        long conflicts = 0;
+        for (std::size_t i = 0; i < size; ++i)
+            g.for_each_neighbour(region[i], [&](const unsigned int u) {
+                ++gamma[i * k + coloring[u] - 1];
+                // each conflict once: counted from its end of lowest slot, the nodes outside have slot none
+                if (coloring[u] == coloring[region[i]] && slot[u] > i) ++conflicts;
+            });
+
+        long best_conflicts = conflicts;
+        std::vector<unsigned int> best(size);
+        for (std::size_t i = 0; i < size; ++i)
+            best[i] = coloring[region[i]];
+        std::vector<std::size_t> conflicting;
+        // gives up after this many moves without a better state
+        const unsigned long patience = 10000 + 10 * size;
+        for (unsigned long iter = 0, last = 0; conflicts > 0 && iter - last < patience;) {
+            if ((++iter & 63) == 0 && std::chrono::steady_clock::now() >= deadline) break;
+            conflicting.clear();
+            for (std::size_t i = 0; i < size; ++i)
+                if (gamma[i * k + coloring[region[i]] - 1] > 0) conflicting.push_back(i);
+
+            // best non tabu move among the conflicting nodes, tabu moves allowed if they remove every conflict
+            std::size_t move_i = size;
+            unsigned int move_c = 0, ties = 0;
+            long move_delta = 0;
+            for (const std::size_t i : conflicting) {
+                const int* gi = gamma.data() + i * k;
+                const unsigned int current = coloring[region[i]] - 1;
+                for (unsigned int c = 0; c < k; ++c) {
+                    if (c == current) continue;
+                    const long delta = gi[c] - gi[current];
+                    if (tabu[i * k + c] > iter && conflicts + delta > 0) continue;
+                    if (move_i == size || delta < move_delta) {
+                        move_i = i, move_c = c, move_delta = delta, ties = 1;
+                    } else if (delta == move_delta && gen() % ++ties == 0) {
+                        move_i = i, move_c = c;
+                    }
+                }
+            }
+            if (move_i == size) continue;
+
+            const unsigned int v = region[move_i];
+            const unsigned int old = coloring[v] - 1;
+            set_color(v, move_c + 1);
+            g.for_each_neighbour(v, [&](const unsigned int u) {
+                if (slot[u] == none) return;
+                --gamma[std::size_t{slot[u]} * k + old];
+                ++gamma[std::size_t{slot[u]} * k + move_c];
+            });
+            conflicts += move_delta;
+            tabu[move_i * k + old] =
+                iter + gen() % 10 + static_cast<unsigned long>(0.6 * static_cast<double>(conflicting.size()));
+
+            if (conflicts < best_conflicts) {
+                best_conflicts = conflicts;
+                last = iter;
+                for (std::size_t i = 0; i < size; ++i)
+                    best[i] = coloring[region[i]];
+            }
+        }
+        for (std::size_t i = 0; i < size; ++i)
+            set_color(region[i], best[i]);
+    }
+
+    // the nodes still in conflict seed the next region
+    conflicted.clear();
+    for (const unsigned int v : region) {
+        slot[v] = none;
+        if (in_conflict(v)) conflicted.push_back(v);
+    }
+    return grown;
+}
+
+template<unsigned int dim>
+void incremental_coloring<dim>::compact() {
+    const unsigned int n = g.size();
+    while (colors > lower_bound()) {
+        bool emptied = true;
+        for (unsigned int v = 0; v < n && emptied; ++v) {
+            if (coloring[v] != colors) continue;
+            const unsigned int c = free_color(v, colors - 1);
+            if (c == 0) {
+                emptied = false;
+                continue;
+            }
+            set_color(v, c);
+        }
+        if (!emptied) break;
+        --colors;
+    }
+
+    // classes emptied on the way leave gaps: number the colors left from 1
+    std::vector<unsigned int> label(colors + 1, 0);
+    for (unsigned int v = 0; v < n; ++v)
+        label[coloring[v]] = 1;
+    unsigned int used = 0;
+    for (unsigned int c = 1; c <= colors; ++c)
+        if (label[c]) label[c] = ++used;
+    if (used == colors) return;
+    for (unsigned int v = 0; v < n; ++v)
+        if (label[coloring[v]] != coloring[v]) set_color(v, label[coloring[v]]);
+    colors = used;
+}
+
+inline std::vector<std::vector<edge_update>> load_updates(const std::string& file_path, const unsigned int nodes) {
+    std::ifstream file(file_path);
+    if (!file) {
+        throw std::runtime_error("Error: Unable to open file " + file_path);
+    }
+
+    std::vector<std::vector<edge_update>> batches(1);
+    std::string line;
+    for (unsigned int number = 1; std::getline(file, line); ++number) {
+        std::istringstream in(line);
+        char kind = 'c';
+        in >> kind;
+        if (kind == 'c') continue;
+        if (kind == 'r') {
+            if (!batches.back().empty()) batches.emplace_back();
+            continue;
+        }
+        unsigned int i = 0, j = 0;
+        if ((kind != 'a' && kind != 'd') || !(in >> i >> j) || i == 0 || j == 0) {
+            throw std::runtime_error("Error: Invalid update at line " + std::to_string(number) + " of " + file_path);
+        }
+        for (const unsigned int v : {i, j})
+            if (v > nodes) {
+                throw std::runtime_error("Error: Node " + std::to_string(v) + " out of range at line " +
+                                         std::to_string(number) + " of " + file_path + ", the graph has " +
+                                         std::to_string(nodes) + " nodes");
+            }
+        if (i == j) {
+            throw std::runtime_error("Error: Self loop on node " + std::to_string(i) + " at line " +
+                                     std::to_string(number) + " of " + file_path);
+        }
+        batches.back().push_back(edge_update{kind == 'a', i - 1, j - 1});
+    }
+    if (batches.back().empty()) batches.pop_back();
+    return batches;
+}
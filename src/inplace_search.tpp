@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+
+template<typename Engine, unsigned int dim>
+inplace_search<Engine, dim>::inplace_search(context<dim>& ctx) : ctx(ctx), g(ctx.g), best{}, color{} {
+    if constexpr (dim == dynamic_dim) {
+        best.assign(g.size(), 0);
+        color.assign(g.size(), 0);
+    }
+    frames.resize(g.size() + 1);
+}
+
+template<typename Engine, unsigned int dim>
+Engine& inplace_search<Engine, dim>::self() {
+    return static_cast<Engine&>(*this);
+}
+
+template<typename Engine, unsigned int dim>
+bool inplace_search<Engine, dim>::found() const {
+    return has_best;
+}
+
+template<typename Engine, unsigned int dim>
+void inplace_search<Engine, dim>::seed(const storage_t<unsigned int, dim>& coloring) {
+    best = coloring;
+    unsigned int colors = 0;
+    for (const unsigned int c : coloring)
+        colors = std::max(colors, c);
+    ctx.colors_ub = colors;
+    has_best = true;
+}
+
+template<typename Engine, unsigned int dim>
+void inplace_search<Engine, dim>::keep_best() {
+    has_best = true;
+    ctx.colors_ub = tot_colors;
+    std::copy(std::begin(color), std::end(color), std::begin(best));
+}
+
+template<typename Engine, unsigned int dim>
+bool inplace_search<Engine, dim>::settled() {
+    if (g.size() == 0) {
+        has_best = true;
+        ctx.colors_ub = 0;
+        return true;
+    }
+    // an incumbent from seed() may already be optimal
+    return has_best && ctx.colors_ub <= ctx.colors_lb;
+}
+
+template<typename Engine, unsigned int dim>
+unsigned int inplace_search<Engine, dim>::color_root(const std::vector<unsigned int>& clique) {
+    for (unsigned int k = 0; k < clique.size(); ++k)
+        self().assign(clique[k], k + 1, g.size());
+    const unsigned int free_nodes = g.size() - static_cast<unsigned int>(clique.size());
+    if (free_nodes == 0 && (!has_best || tot_colors < ctx.colors_ub)) keep_best();
+    return free_nodes;
+}
+
+template<typename Engine, unsigned int dim>
+bool inplace_search<Engine, dim>::search(unsigned int depth, const unsigned int free_nodes) {
+    unsigned long int budget_nodes = 0;
+
+    while (true) {
+        frame& f = frames[depth];
+
+        // take back the color tried last at this depth, if any
+        if (f.color != 0) self().undo(f, depth);
+
+        // a colored dominator leaves a single color worth trying
+        const unsigned int forced = ctx.forced_color(f.node, [&](const unsigned int i) { return color[i]; });
+
+        // a node may open at most one new color, and once a coloring is known only strictly better ones are searched:
+        // a partial coloring that already uses too many colors has no child at all
+        const unsigned int ub = ctx.colors_ub.load(std::memory_order_relaxed);
+        const unsigned int limit = has_best ? ub - 1 : ub;
+        const unsigned int max_color = std::min({tot_colors + 1, limit, ctx.max_colors});
+        const unsigned int c = tot_colors > limit ? 0
+                             : forced != 0   ? (f.color < forced && forced <= max_color ? forced : 0)
+                                             : self().next_color(f.node, f.color, max_color);
+
+        if (ctx.stats) {
+            search_stats::counters& s = ctx.stats->slot(0);
+            if (tot_colors > limit) search_stats::bump(s.prune_bound);
+            // colors between the last one tried and c (or max_color) were skipped as taken by a neighbour
+            else if (forced == 0 && (c != 0 ? c : max_color + 1) > f.color + 1)
+                search_stats::bump(s.prune_infeasible, (c != 0 ? c : max_color + 1) - f.color - 1);
+        }
+
+        if (c == 0) {
+            // no color left for this node: backtrack
+            f.color = 0;
+            if (depth == 0) return false;
+            --depth;
+            continue;
+        }
+
+        f.color = c;
+        f.tot_colors = tot_colors;
+        self().assign(f.node, c, depth);
+        tot_nodes_explored++;
+        if (ctx.stats) {
+            search_stats::bump(ctx.stats->slot(0).nodes);
+            ctx.stats->set_depth(0, depth + 1);
+        }
+
+        const bool complete = depth + 1 == free_nodes;
+        if (complete) {
+            // complete coloring, better than the best one by construction
+            keep_best();
+            if (ctx.stats) ctx.stats->improvement(tot_colors);
+            // the coloring matches the lower bound: it is optimal
+            if (tot_colors <= ctx.colors_lb) return false;
+        }
+
+        // out of budget: stop with the best coloring so far
+        if (ctx.budget && ctx.budget->charge(budget_nodes)) {
+            self().out_of_budget(depth + 1);
+            return true;
+        }
+        self().visited(depth + 1);
+        if (complete) continue;
+
+        ++depth;
+        frames[depth] = frame{self().select_next(f.node), 0, 0};
+    }
+}
@@ -1,56 +1,512 @@
+#include <chrono>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
 #include <vector>
 
-#include <queue>
-#include <stack>
-
+#include "../include/batch.h"
+#include "../include/budget.h"
+#include "../include/checkpoint.h"
+#include "../include/clique.h"
+#include "../include/context.h"
+#include "../include/dfs_engine.h"
+#include "../include/dsatur_engine.h"
 #include "../include/graph.h"
+#include "../include/heuristics.h"
+#include "../include/incremental.h"
+#include "../include/mpi_search.h"
+#include "../include/ordering.h"
+#include "../include/parallel_search.h"
+#include "../include/reduction.h"
+#include "../include/search_strategy.h"
 #include "../include/solution.h"
 
-constexpr unsigned int N = 4;
+// directory of the bundled instances, set by the build to the absolute path of inputs/
+#ifndef GC_INPUT_DIR
+#define GC_INPUT_DIR "../inputs"
+#endif
 
-int main(){
+// graph sizes that get a fixed-size instantiation of graph<dim>/solution<dim>, every other size falls back to
+// the dynamic_dim types. Up to 64 nodes they also get the single_word_dim kernels, rows and node sets in one word
+using fixed_sizes = std::integer_sequence<unsigned int, 4, 11, 23, 25, 36, 47, 49, 64, 125, 250, 450, 500>;
 
-  unsigned long int tot_solutions_generated = 0;
+// command line options
+struct options {
+  std::string file_path = GC_INPUT_DIR "/g.col";
 
-  graph<N> g("../inputs/g.col");
-  //graph<N> g(0.8);
-  std::cout << g << std::endl;
+  // search engine: "stack" (copies solution<dim> objects on a std::stack), "dfs" (in-place search with undo log),
+  // "dsatur" (DSATUR branch and bound over bitset color classes), "parallel" (work-stealing search over
+  // solution<dim> objects) or "mpi" (distributed over MPI ranks, only when built with GC_WITH_MPI)
+  std::string engine = "stack";
+
+  // exploration order of the stack engine, and size of its open list past which the hybrid order goes depth-first
+  strategy order_of_search = strategy::dfs;
+  std::size_t memory_cap_mb = 1024;
+
+  // threads of the parallel engine, and of the pool of batch mode
+  unsigned int threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  // policy choosing the node to branch on
+  selection order = selection::dsatur;
+
+  // symmetries removed from the search tree
+  symmetry symmetries = symmetry::none;
+
+  // heuristic seeding the upper bound before the exact search, and time given to the tabu search
+  warm_start heuristic = warm_start::dsatur;
+  double tabu_time = 1.0;
+
+  // renumbering of the nodes searched, the coloring is reported for the input numbering
+  renumbering renumber = renumbering::none;
+
+  // remove the nodes that cannot change the number of colors and solve each connected component of the rest apart
+  bool reduce = false;
+
+  // keep a binary copy of the input next to it (file_path + ".gcb") and load that one when it is up to date
+  bool cache = false;
+
+  // period in seconds of the live search statistics (0: none), written to stderr or as JSON lines to stats_file
+  double stats_every = 0;
+  std::string stats_file;
+
+  // budget of the whole solve, in seconds and in explored nodes (0: none). Once spent, the best coloring so far is
+  // returned along with the lower bound and the gap between the two
+  double time_limit = 0;
+  unsigned long int node_limit = 0;
+
+  // dfs engine only: file the search is saved to every checkpoint_every seconds and when it stops, and file of a
+  // previous run to continue (usually the same one)
+  std::string checkpoint_path;
+  double checkpoint_every = 60;
+  std::string resume_path;
+
+  // batch mode: directory or list of graph files solved on the threads of one process, one JSON line per graph on
+  // stdout (with its coloring unless batch_colorings is off). Each graph is solved with the settings above, its own
+  // budget included
+  std::string batch_path;
+  bool batch_colorings = true;
+
+  // edge updates applied to the graph once solved, each batch repaired from the previous coloring within tabu_time
+  // seconds (see load_updates() for the format)
+  std::string updates_path;
+
+  // progress of the solve (warm start, reduction, improved solutions), not written if null
+  std::ostream* log = &std::cout;
+};
+
+// loads the input graph, going through the binary cache if enabled (and parsing the text file again if the cache is
+// corrupted)
+template<unsigned int N>
+graph<N> load_graph(const options& opt) {
+  if (!opt.cache || is_binary_graph(opt.file_path))
+    return graph<N>(opt.file_path);
+
+  namespace fs = std::filesystem;
+  const std::string cache_path = opt.file_path + ".gcb";
+  if (fs::exists(cache_path) && fs::last_write_time(cache_path) >= fs::last_write_time(opt.file_path)) {
+    try {
+      return graph<N>(cache_path);
+    } catch (const std::runtime_error&) {
+      // a corrupted cache is parsed again from the text file and rewritten
+    }
+  }
+
+  graph<N> g(opt.file_path);
+  g.save(cache_path);
+  return g;
+}
+
+// explicit stack (or priority queue, with opt.order_of_search) of solution<N>, each child is a full copy of its
+// parent. incumbent (optional) is a known complete solution, only better ones are searched
+template<unsigned int N>
+solution<N> search_stack(context<N>& ctx, const options& opt, const solution<N>* incumbent,
+                         unsigned long int& tot_solutions_generated) {
+  return sequential_search(ctx, incumbent, opt.order_of_search, opt.memory_cap_mb << 20, tot_solutions_generated);
+}
+
+// single coloring colored and uncolored in place
+template<unsigned int N>
+solution<N> search_dfs(context<N>& ctx, const options& opt, const solution<N>* incumbent,
+                       unsigned long int& tot_solutions_generated) {
+
+  dfs_engine<N> engine(ctx);
+  if (incumbent) engine.seed(incumbent->coloring());
+  engine.checkpoint_path = opt.checkpoint_path;
+  engine.checkpoint_period = opt.checkpoint_every;
+  if (!opt.resume_path.empty()) {
+    const checkpoint cp = checkpoint::load(opt.resume_path);
+    engine.resume(cp);
+    std::cout << "Resumed at depth:\t" << cp.path.size() << (cp.done ? " (search over)" : "") << std::endl;
+  }
+  engine.run();
+
+  tot_solutions_generated = engine.tot_nodes_explored;
+  return solution<N>(ctx, engine.best);
+}
+
+// DSATUR branch and bound over bitset color classes, branching on its own saturation order instead of opt.order
+template<unsigned int N>
+solution<N> search_dsatur(context<N>& ctx, const solution<N>* incumbent, unsigned long int& tot_solutions_generated) {
+
+  dsatur_engine<N> engine(ctx);
+  if (incumbent) engine.seed(incumbent->coloring());
+  engine.run();
 
-  solution<N>::g = &g;
+  tot_solutions_generated = engine.tot_nodes_explored;
+  return solution<N>(ctx, engine.best);
+}
 
-  const solution<N> s{};
-  std::stack<solution<N>> q{};
-  q.push(s);
+// subtrees spread over opt.threads threads
+template<unsigned int N>
+solution<N> search_parallel(context<N>& ctx, const options& opt, const solution<N>* incumbent,
+                            unsigned long int& tot_solutions_generated) {
 
-  solution<N> best_so_far;
-  bool first = true;
+  parallel_search<N> search(ctx, opt.threads);
+  const solution<N> best = search.run(incumbent);
 
-  while(!q.empty()) {
-    auto curr = q.top(); q.pop();
-    tot_solutions_generated++;
+  tot_solutions_generated = search.tot_solutions_generated;
+  return best;
+}
 
-    if(!curr.is_final() && curr.tot_colors < solution<N>::colors_ub) {
-      auto tmp = curr.get_next();
-      // add children to the STACK in reverse order, to ensure the first one of the list is popped next
-      for(auto child = tmp.rbegin(); child != tmp.rend(); ++child)
-        q.push(*child);
+#ifdef GC_WITH_MPI
+// subtrees spread over the ranks of MPI_COMM_WORLD
+template<unsigned int N>
+solution<N> search_mpi(context<N>& ctx, const solution<N>* incumbent, unsigned long int& tot_solutions_generated) {
+
+  mpi_search<N> search(ctx, MPI_COMM_WORLD);
+  const solution<N> best = search.run(incumbent);
+
+  tot_solutions_generated = search.tot_solutions_generated;
+  return best;
+}
+#endif
+
+// runs the search engine selected by opt
+template<unsigned int N>
+solution<N> search(context<N>& ctx, const options& opt, const solution<N>* incumbent,
+                   unsigned long int& tot_solutions_generated) {
+  if (opt.engine == "dfs")
+    return search_dfs(ctx, opt, incumbent, tot_solutions_generated);
+  if (!opt.checkpoint_path.empty() || !opt.resume_path.empty())
+    throw std::runtime_error("Error: Checkpoints need the dfs engine");
+  if (opt.engine == "dsatur")
+    return search_dsatur(ctx, incumbent, tot_solutions_generated);
+  if (opt.engine == "parallel")
+    return search_parallel(ctx, opt, incumbent, tot_solutions_generated);
+#ifdef GC_WITH_MPI
+  if (opt.engine == "mpi")
+    return search_mpi(ctx, incumbent, tot_solutions_generated);
+#endif
+  if (opt.engine != "stack")
+    throw std::runtime_error("Error: Unknown search engine " + opt.engine);
+  return search_stack(ctx, opt, incumbent, tot_solutions_generated);
+}
+
+// colors g with as few colors as possible, knowing it needs at least colors_lb: heuristic warm start, then exact
+// search with the engine of opt until it ends or budget is spent. The search counts its work in stats
+template<unsigned int N>
+storage_t<unsigned int, N> color_graph(const graph<N>& g, const options& opt, search_budget& budget,
+                                       search_stats& stats, const unsigned int colors_lb,
+                                       unsigned long int& tot_solutions_generated) {
+
+  const node_selector<N> selector(g, opt.order);
+
+  context<N> ctx(g, &selector);
+  ctx.colors_lb = colors_lb;
+  ctx.break_symmetries(opt.symmetries);
+
+  ctx.stats = &stats;
+  ctx.budget = &budget;
+  ctx.log = opt.log;
+
+  // seed colors_ub with a heuristic coloring
+  std::unique_ptr<solution<N>> incumbent;
+  if (opt.heuristic != warm_start::none) {
+    auto coloring = opt.heuristic == warm_start::greedy ? greedy_coloring(g, degree_order(g)) : dsatur_coloring(g);
+    // the tabu search is part of the budget: it gets no more than the time left, and stops on a signal
+    if (opt.heuristic == warm_start::tabucol)
+      coloring = tabucol(g, coloring, ctx.colors_lb, std::min(opt.tabu_time, budget.remaining()), &budget);
+    incumbent = std::make_unique<solution<N>>(ctx, coloring);
+    ctx.colors_ub = incumbent->tot_colors;
+    stats.improvement(incumbent->tot_colors);
+    if (opt.log) *opt.log << "Warm start colors:\t" << incumbent->tot_colors << std::endl;
+  }
 
+  const solution<N> best = search(ctx, opt, incumbent.get(), tot_solutions_generated);
+  // stopped before any complete coloring: fall back to DSATUR, the answer stays valid
+  if (best.size() != g.size() || !best.is_final()) return dsatur_coloring(g);
+  return best.coloring();
+}
+
+// colors the components left by reduce() one after the other, each one only needs as many colors as the worst one
+// before it
+template<unsigned int N>
+storage_t<unsigned int, N> color_reduced(const graph<N>& g, const options& opt, search_budget& budget,
+                                         search_stats& stats, const unsigned int colors_lb,
+                                         unsigned long int& tot_solutions_generated) {
+
+  const reduction r = reduce(g, colors_lb);
+  if (opt.log)
+    *opt.log << "Reduced graph:\t\t" << r.core_size() << " nodes in " << r.components.size() << " components"
+             << std::endl;
+
+  unsigned int colors = colors_lb;
+  std::vector<std::vector<unsigned int>> colorings;
+  for (const auto& c : r.components) {
+    std::vector<unsigned int> coloring(c.size());
+    if (c.size() <= colors) {
+      // every node can get its own color
+      for (unsigned int i = 0; i < c.size(); ++i)
+        coloring[i] = i + 1;
     } else {
-      // check if the current solution is better than the previous one
-      if (first || curr.tot_colors < solution<N>::colors_ub) {
-        first = false;
-        solution<N>::colors_ub = curr.tot_colors;
-        best_so_far = curr;
-        std::cout << curr << std::endl;
+      unsigned long int count = 0;
+      coloring = color_graph(c, opt, budget, stats, colors, count);
+      tot_solutions_generated += count;
+    }
+    colors = std::max(colors, colors_used<dynamic_dim>(coloring));
+    colorings.push_back(std::move(coloring));
+  }
+
+  return restore(g, r, colorings);
+}
+
+// applies the batches of updates to g colored by coloring, repairing the coloring after each one
+template<unsigned int N>
+void update_graph(const graph<N>& g, const storage_t<unsigned int, N>& coloring, std::vector<unsigned int> clique,
+                  const std::vector<std::vector<edge_update>>& batches, const options& opt) {
+
+  incremental_coloring<N> inc(g, coloring, std::move(clique));
+  for (std::size_t b = 0; b < batches.size(); ++b) {
+    unsigned int added = 0, removed = 0;
+    for (const edge_update& u : batches[b]) {
+      if (u.add) {
+        inc.add_edge(u.i, u.j);
+        ++added;
+      } else {
+        inc.remove_edge(u.i, u.j);
+        ++removed;
       }
     }
+    const auto start = std::chrono::steady_clock::now();
+    inc.repair(opt.tabu_time);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Update " << b + 1 << ":\t\t+" << added << " -" << removed << " edges, " << inc.colors
+              << " colors (lb " << inc.lower_bound() << "), " << inc.recolored << " nodes recolored in " << ms
+              << "ms" << std::endl;
+  }
+
+  const context<N> ctx(inc.g);
+  const solution<N> updated(ctx, inc.coloring);
+  std::cout << "==== Updated Solution ====\n" << updated << "Color ub:\t\t" << inc.colors << "\n"
+            << "Color lb:\t\t" << inc.lower_bound() << "\n"
+            << "==========================\n";
+}
+
+template<unsigned int N>
+int solve(const options& opt) {
+
+  unsigned long int tot_solutions_generated = 0;
+  search_budget budget(opt.time_limit, opt.node_limit);
+
+  // one slot of counters per search thread, sampled while the search runs if asked to. Shared by the components of
+  // --reduce, so a single report covers the whole run
+  search_stats stats(opt.engine == "parallel" ? opt.threads : 1);
+  std::optional<stats_reporter> reporter;
+  if (opt.stats_every > 0) reporter.emplace(stats, opt.stats_every, opt.stats_file);
+
+  const graph<N> input = load_graph<N>(opt);
+  //graph<N> g(0.8);
+  if (input.size() <= 32)
+    std::cout << input << std::endl;
+
+  // read before the search, to report a bad file at once
+  const auto updates = opt.updates_path.empty() ? std::vector<std::vector<edge_update>>{}
+                                                : load_updates(opt.updates_path, input.size());
+
+  // the search runs on the renumbered graph, its coloring and clique are mapped back to the input nodes
+  const std::vector<unsigned int> order = renumbering_order(input, opt.renumber);
+  std::optional<graph<N>> renumbered;
+  if (!order.empty()) renumbered.emplace(input, order);
+  const graph<N>& g = renumbered ? *renumbered : input;
+
+  context<N> ctx(input);
+  std::vector<unsigned int> clique = greedy_clique(g);
+  ctx.colors_lb = clique.size();
+  std::cout << "Clique lower bound:\t" << ctx.colors_lb << std::endl;
 
-    //std::cout << curr << std::endl;
+  if (opt.reduce && (!opt.checkpoint_path.empty() || !opt.resume_path.empty()))
+    throw std::runtime_error("Error: Checkpoints cannot be combined with --reduce");
+  auto coloring = opt.reduce ? color_reduced(g, opt, budget, stats, ctx.colors_lb, tot_solutions_generated)
+                             : color_graph(g, opt, budget, stats, ctx.colors_lb, tot_solutions_generated);
+  if (renumbered) {
+    coloring = original_coloring<N>(coloring, order);
+    for (unsigned int& v : clique)
+      v = order[v];
   }
+  const solution<N> best_so_far(ctx, coloring);
+  ctx.colors_ub = best_so_far.tot_colors;
 
-  std::cout << "==== Optimal Solution ====\n" << best_so_far << "==========================\n";
+  if (budget.stopped()) {
+    // anytime answer: the coloring is the best found in the budget, the optimum lies between the two bounds
+    const unsigned int gap = ctx.colors_ub - std::min<unsigned int>(ctx.colors_ub, ctx.colors_lb);
+    std::cout << "==== Best Solution ====\n" << best_so_far << "Color ub:\t\t" << ctx.colors_ub << "\n"
+              << "Color lb:\t\t" << ctx.colors_lb << "\n"
+              << "Gap:\t\t\t" << gap << " (" << (ctx.colors_ub ? 100.0 * gap / ctx.colors_ub : 0.0) << "%)\n"
+              << "Stopped by:\t\t" << stop_reason_name(budget.reason()) << " after " << budget.elapsed() << "s\n"
+              << "=======================\n";
+  } else {
+    std::cout << "==== Optimal Solution ====\n" << best_so_far << "Color ub:\t\t" << ctx.colors_ub << "\n"
+              << "==========================\n";
+  }
   std::cout << "Tot solutions explored:\t" << tot_solutions_generated << std::endl;
 
+  if (!opt.updates_path.empty()) update_graph(input, coloring, std::move(clique), updates, opt);
   return 0;
-}
\ No newline at end of file
+}
+
+// solves the graphs of opt.batch_path with the engine and settings of a single graph, returns 1 if some could not be
+// solved
+int solve_batch_mode(const options& opt) {
+  // options writing files or run state of their own, that the graphs of a batch would share
+  if (opt.engine == "mpi" || opt.stats_every > 0 || !opt.stats_file.empty() || !opt.checkpoint_path.empty() ||
+      !opt.resume_path.empty() || opt.cache || !opt.updates_path.empty())
+    throw std::runtime_error("Error: --batch cannot be combined with --engine mpi, --stats-every, --stats-file, "
+                             "--checkpoint, --resume, --cache or --updates");
+
+  batch_options bopt;
+  bopt.threads = opt.threads;
+  bopt.renumber = opt.renumber;
+  bopt.time_limit = opt.time_limit;
+  bopt.node_limit = opt.node_limit;
+  bopt.colorings = opt.batch_colorings;
+
+  // stdout only gets the JSON lines. The pool already runs opt.threads graphs at once, so a parallel search runs on
+  // a single thread per graph rather than opt.threads more each
+  options quiet = opt;
+  quiet.log = nullptr;
+  quiet.threads = 1;
+  const auto color = [&](const graph<dynamic_dim>& g, search_budget& budget, const unsigned int colors_lb,
+                         unsigned long int& explored) {
+    search_stats stats(1);
+    return opt.reduce ? color_reduced(g, quiet, budget, stats, colors_lb, explored)
+                      : color_graph(g, quiet, budget, stats, colors_lb, explored);
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<std::string> files = batch_inputs(opt.batch_path);
+  unsigned int solved = 0, optimal = 0, errors = 0;
+  solve_batch(files, bopt, color, [&](const batch_result& r) {
+    write_json_line(std::cout, r, bopt.colorings);
+    if (!r.error.empty()) {
+      ++errors;
+      return;
+    }
+    ++solved;
+    optimal += r.optimal;
+  });
+
+  const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cerr << "Batch: " << solved << " of " << files.size() << " graphs solved (" << optimal << " optimal, "
+            << errors << " errors) in " << s << "s" << std::endl;
+  return errors != 0;
+}
+
+// runs the fixed-size solver matching the number of nodes, or the dynamic one if there is none
+template<unsigned int... sizes>
+int dispatch(const unsigned int nodes, std::integer_sequence<unsigned int, sizes...>, const options& opt) {
+  int ret = 0;
+  const bool found = ((nodes == sizes && ((ret = solve<sizes>(opt)), true)) || ...);
+  return found ? ret : solve<dynamic_dim>(opt);
+}
+
+int main(int argc, char* argv[]){
+
+  options opt;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+      opt.engine = argv[++i];
+    } else if (std::strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) {
+      opt.order_of_search = parse_strategy(argv[++i]);
+    } else if (std::strcmp(argv[i], "--memory-cap") == 0 && i + 1 < argc) {
+      opt.memory_cap_mb = std::stoul(argv[++i]);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      opt.threads = std::stoul(argv[++i]);
+    } else if (std::strcmp(argv[i], "--order") == 0 && i + 1 < argc) {
+      opt.order = parse_selection(argv[++i]);
+    } else if (std::strcmp(argv[i], "--symmetry") == 0 && i + 1 < argc) {
+      opt.symmetries = parse_symmetry(argv[++i]);
+    } else if (std::strcmp(argv[i], "--warm-start") == 0 && i + 1 < argc) {
+      opt.heuristic = parse_warm_start(argv[++i]);
+    } else if (std::strcmp(argv[i], "--tabu-time") == 0 && i + 1 < argc) {
+      opt.tabu_time = std::stod(argv[++i]);
+    } else if (std::strcmp(argv[i], "--renumber") == 0 && i + 1 < argc) {
+      opt.renumber = parse_renumbering(argv[++i]);
+    } else if (std::strcmp(argv[i], "--reduce") == 0) {
+      opt.reduce = true;
+    } else if (std::strcmp(argv[i], "--cache") == 0) {
+      opt.cache = true;
+    } else if (std::strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) {
+      opt.time_limit = std::stod(argv[++i]);
+    } else if (std::strcmp(argv[i], "--node-limit") == 0 && i + 1 < argc) {
+      opt.node_limit = std::stoul(argv[++i]);
+    } else if (std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+      opt.checkpoint_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) {
+      opt.checkpoint_every = std::stod(argv[++i]);
+    } else if (std::strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+      opt.resume_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+      opt.batch_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--no-colorings") == 0) {
+      opt.batch_colorings = false;
+    } else if (std::strcmp(argv[i], "--updates") == 0 && i + 1 < argc) {
+      opt.updates_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--stats-every") == 0 && i + 1 < argc) {
+      opt.stats_every = std::stod(argv[++i]);
+    } else if (std::strcmp(argv[i], "--stats-file") == 0 && i + 1 < argc) {
+      opt.stats_file = argv[++i];
+    } else if (argv[i][0] == '-') {
+      std::cerr << "Usage: " << argv[0] << " [--engine stack|dfs|dsatur|parallel|mpi] [--threads n]\n"
+                << "       [--strategy dfs|best-first|lds|hybrid] [--memory-cap MB]\n"
+                << "       [--order input|degree|smallest-last|dsatur] [--symmetry none|clique|dominance]\n"
+                << "       [--warm-start none|greedy|dsatur|tabucol] [--tabu-time seconds]\n"
+                << "       [--renumber none|degree|degeneracy|rcm]\n"
+                << "       [--reduce] [--cache] [--time-limit seconds] [--node-limit n]\n"
+                << "       [--checkpoint path] [--checkpoint-every seconds] [--resume path]\n"
+                << "       [--stats-every seconds] [--stats-file path]\n"
+                << "       [--batch directory | list.txt] [--no-colorings] [--updates path]\n"
+                << "       [file.col | file.gcb]\n";
+      return 1;
+    } else {
+      opt.file_path = argv[i];
+    }
+  }
+
+#ifdef GC_WITH_MPI
+  MPI_Init(&argc, &argv);
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  // only rank 0 reports
+  if (rank != 0) std::cout.setstate(std::ios::failbit);
+#endif
+
+  // SIGINT and SIGTERM end the search early, the best coloring so far is still reported
+  search_budget::catch_signals();
+
+  int ret;
+  try {
+    ret = opt.batch_path.empty() ? dispatch(graph_nodes(opt.file_path), fixed_sizes{}, opt) : solve_batch_mode(opt);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    ret = 1;
+  }
+
+#ifdef GC_WITH_MPI
+  MPI_Finalize();
+#endif
+  return ret;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+
+template<unsigned int dim>
+mpi_search<dim>::mpi_search(context<dim>& ctx, MPI_Comm parent) : ctx(ctx) {
+    MPI_Comm_dup(parent, &comm);
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    gen.seed(rank);
+}
+
+template<unsigned int dim>
+mpi_search<dim>::~mpi_search() {
+    MPI_Comm_free(&comm);
+}
+
+template<unsigned int dim>
+void mpi_search<dim>::broadcast_ub(const unsigned int ub) {
+    // the search goes on while the bound travels, drain() waits for the sends to be matched
+    const unsigned int& value = sent_ubs.emplace_back(ub);
+    for (int r = 0; r < size; ++r) {
+        if (r == rank) continue;
+        MPI_Issend(&value, 1, MPI_UNSIGNED, r, tag_ub, comm, &sends.emplace_back());
+    }
+}
+
+template<unsigned int dim>
+void mpi_search<dim>::send_empty(const int to, const tag t) {
+    MPI_Issend(nullptr, 0, MPI_UNSIGNED, to, t, comm, &sends.emplace_back());
+}
+
+template<unsigned int dim>
+void mpi_search<dim>::drain() {
+    // a synchronous send completes once it is matched, which needs its receiver to keep polling: every rank polls
+    // until its own sends are done, then until all the ranks are, which the non-blocking barrier tells
+    for (int done = 0; !done; poll())
+        MPI_Testall(static_cast<int>(sends.size()), sends.data(), &done, MPI_STATUSES_IGNORE);
+    MPI_Request barrier;
+    MPI_Ibarrier(comm, &barrier);
+    for (int done = 0; !done; poll())
+        MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+    sends.clear();
+    sent_ubs.clear();
+}
+
+template<unsigned int dim>
+void mpi_search<dim>::process(const solution<dim>& curr) {
+    explored++;
+    search_stats::counters* s = ctx.stats ? &ctx.stats->slot(0) : nullptr;
+    if (s) {
+        search_stats::bump(s->nodes);
+        ctx.stats->set_depth(0, stack.size());
+    }
+
+    const unsigned int ub = ctx.colors_ub;
+    if (curr.is_final()) {
+        if (curr.tot_colors < ub && ctx.improve_ub(curr.tot_colors)) {
+            best_so_far = curr;
+            has_best = true;
+            broadcast_ub(curr.tot_colors);
+            if (ctx.stats) ctx.stats->improvement(curr.tot_colors);
+        }
+    } else if (curr.tot_colors < ub && curr.bound(ctx) < ub) {
+        unsigned int rejected = 0;
+        auto tmp = curr.get_next(ctx, &rejected);
+        if (s) search_stats::bump(s->prune_infeasible, rejected);
+        // add children in reverse order, to ensure the first one of the list is popped next
+        for (auto child = tmp.rbegin(); child != tmp.rend(); ++child)
+            stack.push_back(std::move(*child));
+    } else if (s) {
+        search_stats::bump(s->prune_bound);
+    }
+}
+
+template<unsigned int dim>
+void mpi_search<dim>::poll() {
+    int flag = 1;
+    MPI_Status status;
+    while (true) {
+        MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm, &flag, &status);
+        if (!flag) break;
+        const int from = status.MPI_SOURCE;
+
+        switch (status.MPI_TAG) {
+        case tag_request: {
+            MPI_Recv(nullptr, 0, MPI_UNSIGNED, from, tag_request, comm, MPI_STATUS_IGNORE);
+            if (terminated) {
+                // the requesting rank is shutting down as well
+            } else if (stack.size() > 1) {
+                // hand over the oldest node, closest to the root
+                const auto coloring = stack.front().coloring();
+                stack.pop_front();
+                MPI_Send(coloring.data(), static_cast<int>(coloring.size()), MPI_UNSIGNED, from, tag_work, comm);
+                ++msg_count;
+            } else {
+                send_empty(from, tag_no_work);
+            }
+            break;
+        }
+        case tag_work: {
+            auto coloring = make_storage<unsigned int, dim>(ctx.g.size());
+            MPI_Recv(coloring.data(), static_cast<int>(coloring.size()), MPI_UNSIGNED, from, tag_work, comm,
+                     MPI_STATUS_IGNORE);
+            stack.emplace_back(ctx, coloring);
+            --msg_count;
+            black = true;
+            request_pending = false;
+            break;
+        }
+        case tag_no_work:
+            MPI_Recv(nullptr, 0, MPI_UNSIGNED, from, tag_no_work, comm, MPI_STATUS_IGNORE);
+            request_pending = false;
+            break;
+        case tag_ub: {
+            unsigned int ub;
+            MPI_Recv(&ub, 1, MPI_UNSIGNED, from, tag_ub, comm, MPI_STATUS_IGNORE);
+            ctx.improve_ub(ub);
+            break;
+        }
+        case tag_token: {
+            long token[2];
+            MPI_Recv(token, 2, MPI_LONG, from, tag_token, comm, MPI_STATUS_IGNORE);
+            token_count = token[0];
+            token_black = token[1] != 0;
+            has_token = true;
+            break;
+        }
+        case tag_terminate:
+            MPI_Recv(nullptr, 0, MPI_UNSIGNED, from, tag_terminate, comm, MPI_STATUS_IGNORE);
+            terminated = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // forget the sends matched by now (MPI_Test frees them)
+    std::erase_if(sends, [](MPI_Request& r) {
+        int done = 0;
+        MPI_Test(&r, &done, MPI_STATUS_IGNORE);
+        return done != 0;
+    });
+
+    // a bound matching the lower bound is optimal: the remaining work can be dropped
+    if (ctx.colors_ub <= ctx.colors_lb) stack.clear();
+}
+
+template<unsigned int dim>
+void mpi_search<dim>::handle_token() {
+    if (!stack.empty() || terminated) return;
+
+    if (rank == 0) {
+        if (has_token) {
+            has_token = false;
+            token_out = false;
+            if (!token_black && !black && token_count + msg_count == 0) {
+                for (int r = 1; r < size; ++r)
+                    MPI_Send(nullptr, 0, MPI_UNSIGNED, r, tag_terminate, comm);
+                terminated = true;
+                return;
+            }
+        }
+        if (!token_out) {
+            // start a new round
+            black = false;
+            token_out = true;
+            long token[2] = {0, 0};
+            MPI_Send(token, 2, MPI_LONG, size - 1, tag_token, comm);
+        }
+    } else if (has_token) {
+        long token[2] = {token_count + msg_count, token_black || black ? 1 : 0};
+        MPI_Send(token, 2, MPI_LONG, rank - 1, tag_token, comm);
+        has_token = false;
+        black = false;
+    }
+}
+
+template<unsigned int dim>
+solution<dim> mpi_search<dim>::run(const solution<dim>* incumbent) {
+    // agree on the best bound known by any rank
+    unsigned int ub = incumbent ? incumbent->tot_colors : ctx.g.size() + 1;
+    MPI_Allreduce(MPI_IN_PLACE, &ub, 1, MPI_UNSIGNED, MPI_MIN, comm);
+    ctx.colors_ub = ub;
+    if (incumbent && incumbent->tot_colors == ub) {
+        best_so_far = *incumbent;
+        has_best = true;
+    }
+
+    if (ub > ctx.colors_lb) {
+        // static partition: every rank expands the same frontier breadth-first and keeps its share of it
+        std::deque<solution<dim>> frontier;
+        frontier.emplace_back(ctx);
+        while (!frontier.empty() && frontier.size() < 4 * static_cast<std::size_t>(size)) {
+            const solution<dim> curr = std::move(frontier.front());
+            frontier.pop_front();
+            process(curr);
+            // nodes of the frontier are only counted once, by rank 0
+            if (rank != 0) explored--;
+            while (!stack.empty()) {
+                frontier.push_back(std::move(stack.back()));
+                stack.pop_back();
+            }
+        }
+        for (std::size_t i = 0; i < frontier.size(); ++i)
+            if (static_cast<int>(i % size) == rank) stack.push_back(std::move(frontier[i]));
+
+        std::uniform_int_distribution<int> victim(0, std::max(size - 2, 0));
+        unsigned int since_poll = 0;
+        unsigned long int budget_nodes = 0;
+        while (!terminated) {
+            // out of budget: the rank drops its open nodes and stops asking for more, the termination detection
+            // then runs as if the work were done
+            if (!stack.empty() && ctx.budget && ctx.budget->charge(budget_nodes)) stack.clear();
+            const bool stopped = ctx.budget && ctx.budget->stopped();
+            if (!stack.empty()) {
+                const solution<dim> curr = std::move(stack.back());
+                stack.pop_back();
+                process(curr);
+                if (++since_poll < poll_interval) continue;
+                since_poll = 0;
+            } else if (!request_pending && size > 1 && !stopped) {
+                // ask a random other rank for work
+                int r = victim(gen);
+                if (r >= rank) ++r;
+                send_empty(r, tag_request);
+                request_pending = true;
+            } else if (size == 1) {
+                terminated = true;
+            }
+            poll();
+            handle_token();
+        }
+
+        // receive the requests, replies and bounds still in flight
+        drain();
+    }
+
+    MPI_Allreduce(&explored, &tot_solutions_generated, 1, MPI_UNSIGNED_LONG, MPI_SUM, comm);
+
+    // the rank holding the best solution sends it to everybody
+    struct { int ub; int rank; } mine{has_best ? static_cast<int>(best_so_far.tot_colors) : INT_MAX, rank}, global{};
+    MPI_Allreduce(&mine, &global, 1, MPI_2INT, MPI_MINLOC, comm);
+    // stopped by the budget before any rank found a coloring: no solution, on every rank
+    if (global.ub == INT_MAX) return solution<dim>();
+
+    auto coloring = make_storage<unsigned int, dim>(ctx.g.size());
+    if (rank == global.rank) {
+        const auto best = best_so_far.coloring();
+        std::copy(std::begin(best), std::end(best), std::begin(coloring));
+    }
+    MPI_Bcast(coloring.data(), static_cast<int>(coloring.size()), MPI_UNSIGNED, global.rank, comm);
+    ctx.colors_ub = static_cast<unsigned int>(global.ub);
+    return solution<dim>(ctx, coloring);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <algorithm>
+
+template<unsigned int dim>
+node_stack<dim>::node_stack(const std::size_t capacity) {
+    slots.reserve(capacity);
+}
+
+template<unsigned int dim>
+bool node_stack<dim>::empty() const {
+    return used == 0;
+}
+
+template<unsigned int dim>
+std::size_t node_stack<dim>::size() const {
+    return used;
+}
+
+template<unsigned int dim>
+std::size_t node_stack<dim>::peak() const {
+    return max_used;
+}
+
+template<unsigned int dim>
+solution<dim>& node_stack<dim>::top() {
+    return slots[used - 1];
+}
+
+template<unsigned int dim>
+solution<dim>& node_stack<dim>::push() {
+    if (used == slots.size()) slots.emplace_back();
+    max_used = std::max(max_used, ++used);
+    return slots[used - 1];
+}
+
+template<unsigned int dim>
+void node_stack<dim>::pop() {
+    --used;
+}
+
+template<unsigned int dim>
+void node_stack<dim>::clear() {
+    used = 0;
+}
+
+template<unsigned int dim>
+void node_stack<dim>::reserve(const std::size_t n) {
+    if (used + n > slots.capacity())
+        slots.reserve(std::max(used + n, 2 * slots.capacity()));
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+inline selection parse_selection(const std::string& name) {
+    if (name == "input") return selection::input;
+    if (name == "degree") return selection::degree;
+    if (name == "smallest-last") return selection::smallest_last;
+    if (name == "dsatur") return selection::dsatur;
+    throw std::runtime_error("Error: Unknown node selection policy " + name);
+}
+
+inline renumbering parse_renumbering(const std::string& name) {
+    if (name == "none") return renumbering::none;
+    if (name == "degree") return renumbering::degree;
+    if (name == "degeneracy") return renumbering::degeneracy;
+    if (name == "rcm") return renumbering::rcm;
+    throw std::runtime_error("Error: Unknown renumbering " + name);
+}
+
+template<unsigned int dim>
+std::vector<unsigned int> degree_order(const graph<dim>& g) {
+    std::vector<unsigned int> order(g.size()), degree(g.size());
+    std::iota(order.begin(), order.end(), 0);
+    for (unsigned int i = 0; i < g.size(); ++i)
+        degree[i] = g.degree(i);
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned int a, const unsigned int b) {
+        return degree[a] > degree[b];
+    });
+    return order;
+}
+
+template<unsigned int dim>
+std::vector<unsigned int> smallest_last_order(const graph<dim>& g) {
+    const unsigned int n = g.size();
+
+    // bucket queue of the nodes still in the graph, by current degree
+    std::vector<unsigned int> degree(n);
+    std::vector<std::vector<unsigned int>> buckets(n);
+    for (unsigned int i = 0; i < n; ++i) {
+        degree[i] = g.degree(i);
+        buckets[degree[i]].push_back(i);
+    }
+
+    std::vector<bool> removed(n, false);
+    std::vector<unsigned int> order(n);
+    unsigned int d = 0;
+    for (unsigned int k = n; k-- > 0;) {
+        // lazily skip stale entries: a node may appear in several buckets, only the one of its degree counts
+        unsigned int v;
+        while (true) {
+            while (buckets[d].empty()) ++d;
+            v = buckets[d].back();
+            buckets[d].pop_back();
+            if (!removed[v] && degree[v] == d) break;
+        }
+
+        removed[v] = true;
+        order[k] = v;
+        g.for_each_neighbour(v, [&](const unsigned int u) {
+            if (!removed[u]) buckets[--degree[u]].push_back(u);
+        });
+        // removing v lowers the degree of its neighbours by at most one
+        d = d > 0 ? d - 1 : 0;
+    }
+    return order;
+}
+
+template<unsigned int dim>
+std::vector<unsigned int> rcm_order(const graph<dim>& g) {
+    const unsigned int n = g.size();
+    std::vector<unsigned int> degree(n), starts(n);
+    for (unsigned int i = 0; i < n; ++i)
+        degree[i] = g.degree(i);
+    std::iota(starts.begin(), starts.end(), 0);
+    std::stable_sort(starts.begin(), starts.end(), [&](const unsigned int a, const unsigned int b) {
+        return degree[a] < degree[b];
+    });
+    const auto by_degree = [&](const unsigned int a, const unsigned int b) {
+        return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+    };
+
+    // order doubles as the queue of the breadth-first search
+    std::vector<unsigned int> order;
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+    for (const unsigned int s : starts) {
+        if (visited[s]) continue;
+        visited[s] = true;
+        order.push_back(s);
+        for (std::size_t head = order.size() - 1; head < order.size(); ++head) {
+            const std::size_t first = order.size();
+            g.for_each_neighbour(order[head], [&](const unsigned int u) {
+                if (visited[u]) return;
+                visited[u] = true;
+                order.push_back(u);
+            });
+            std::sort(order.begin() + static_cast<std::ptrdiff_t>(first), order.end(), by_degree);
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+template<unsigned int dim>
+std::vector<unsigned int> renumbering_order(const graph<dim>& g, const renumbering r) {
+    switch (r) {
+    case renumbering::degree: return degree_order(g);
+    case renumbering::degeneracy: return smallest_last_order(g);
+    case renumbering::rcm: return rcm_order(g);
+    default: return {};
+    }
+}
+
+template<unsigned int dim>
+storage_t<unsigned int, dim> original_coloring(const storage_t<unsigned int, dim>& coloring,
+                                               const std::vector<unsigned int>& order) {
+    auto original = make_storage<unsigned int, dim>(static_cast<unsigned int>(order.size()));
+    for (std::size_t i = 0; i < order.size(); ++i)
+        original[order[i]] = coloring[i];
+    return original;
+}
+
+template<unsigned int dim>
+node_selector<dim>::node_selector(const graph<dim>& g, const selection policy)
+    : policy(policy), rank(g.size()), degree(g.size()) {
+    for (unsigned int i = 0; i < g.size(); ++i)
+        degree[i] = g.degree(i);
+
+    if (policy == selection::degree) {
+        order = degree_order(g);
+    } else if (policy == selection::smallest_last) {
+        order = smallest_last_order(g);
+    } else {
+        order.resize(g.size());
+        std::iota(order.begin(), order.end(), 0);
+    }
+    for (unsigned int i = 0; i < g.size(); ++i)
+        rank[order[i]] = i;
+}
+
+template<unsigned int dim>
+template<typename Color, typename Saturation>
+unsigned int node_selector<dim>::next(const unsigned int last, Color&& color, Saturation&& saturation) const {
+    const auto n = static_cast<unsigned int>(order.size());
+
+    if (policy != selection::dsatur) {
+        // every node before last in the static order is colored already
+        for (unsigned int k = last >= n ? 0 : rank[last] + 1; k < n; ++k)
+            if (color(order[k]) == 0) return order[k];
+        return n;
+    }
+
+    unsigned int best = n, best_sat = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        if (color(i) != 0) continue;
+        const unsigned int sat = saturation(i);
+        if (best == n || sat > best_sat || (sat == best_sat && degree[i] > degree[best])) {
+            best = i;
+            best_sat = sat;
+        }
+    }
+    return best;
+}
+
+template<unsigned int dim>
+template<typename Saturation>
+unsigned int node_selector<dim>::next_open(const unsigned int last, const uint64_t open,
+                                          Saturation&& saturation) const {
+    static_assert(single_word_dim<dim>, "The open nodes of the graph do not fit a word");
+    if (open == 0) return dim;
+
+    if (policy != selection::dsatur) {
+        for (unsigned int k = last >= dim ? 0 : rank[last] + 1; k < dim; ++k)
+            if ((open >> order[k]) & 1) return order[k];
+        return dim;
+    }
+
+    // same choice as next(): the open nodes in increasing order, ties kept by the first one
+    unsigned int best = dim, best_sat = 0;
+    for (uint64_t w = open; w != 0; w &= w - 1) {
+        const auto i = static_cast<unsigned int>(std::countr_zero(w));
+        const unsigned int sat = saturation(i);
+        if (best == dim || sat > best_sat || (sat == best_sat && degree[i] > degree[best])) {
+            best = i;
+            best_sat = sat;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <thread>
+
+template<unsigned int dim>
+parallel_search<dim>::parallel_search(context<dim>& ctx, const unsigned int threads)
+    : ctx(ctx), threads(std::max(threads, 1u)) {
+    for (unsigned int t = 0; t < this->threads; ++t)
+        workers.emplace_back(std::make_unique<worker>());
+}
+
+template<unsigned int dim>
+void parallel_search<dim>::process(const unsigned int id, const solution<dim>& curr) {
+    worker& w = *workers[id];
+    w.explored++;
+    search_stats::counters* s = ctx.stats ? &ctx.stats->slot(id) : nullptr;
+    if (s) {
+        search_stats::bump(s->nodes);
+        // thieves pop from the deque while this runs
+        std::lock_guard lock(w.m);
+        ctx.stats->set_depth(id, w.q.size());
+    }
+
+    const unsigned int ub = ctx.colors_ub.load(std::memory_order_relaxed);
+    if (curr.is_final()) {
+        if (curr.tot_colors < ub) {
+            std::lock_guard lock(best_mutex);
+            if (ctx.improve_ub(curr.tot_colors)) {
+                best_so_far = curr;
+                has_best = true;
+                if (ctx.log) *ctx.log << curr << std::endl;
+                if (ctx.stats) ctx.stats->improvement(curr.tot_colors);
+                // the solution matches the lower bound: it is optimal
+                if (curr.tot_colors <= ctx.colors_lb) done = true;
+            }
+        }
+    } else if (curr.tot_colors < ub && curr.bound(ctx) < ub) {
+        unsigned int rejected = 0;
+        auto tmp = curr.get_next(ctx, &rejected);
+        if (s) search_stats::bump(s->prune_infeasible, rejected);
+        pending += tmp.size();
+        std::lock_guard lock(w.m);
+        // add children in reverse order, to ensure the first one of the list is popped next
+        for (auto child = tmp.rbegin(); child != tmp.rend(); ++child)
+            w.q.push_back(std::move(*child));
+    } else if (s) {
+        search_stats::bump(s->prune_bound);
+    }
+}
+
+template<unsigned int dim>
+bool parallel_search<dim>::take(const unsigned int id, solution<dim>& out) {
+    {
+        worker& w = *workers[id];
+        std::lock_guard lock(w.m);
+        if (!w.q.empty()) {
+            out = std::move(w.q.back());
+            w.q.pop_back();
+            return true;
+        }
+    }
+    for (unsigned int k = 1; k < threads; ++k) {
+        worker& victim = *workers[(id + k) % threads];
+        std::lock_guard lock(victim.m);
+        if (!victim.q.empty()) {
+            out = std::move(victim.q.front());
+            victim.q.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+template<unsigned int dim>
+void parallel_search<dim>::work(const unsigned int id) {
+    solution<dim> curr;
+    unsigned long int budget_nodes = 0;
+    while (!done && pending > 0) {
+        if (!take(id, curr)) {
+            std::this_thread::yield();
+            continue;
+        }
+        process(id, curr);
+        --pending;
+        // out of budget: every worker leaves its open nodes
+        if (ctx.budget && ctx.budget->charge(budget_nodes)) done = true;
+    }
+}
+
+template<unsigned int dim>
+solution<dim> parallel_search<dim>::run(const solution<dim>* incumbent) {
+    if (incumbent) {
+        best_so_far = *incumbent;
+        has_best = true;
+        if (ctx.colors_ub <= ctx.colors_lb) return best_so_far;
+    } else {
+        // without an incumbent, any complete solution is an improvement
+        ctx.colors_ub = ctx.g.size() + 1;
+    }
+
+    // split the tree near the root, breadth-first, until every thread gets a few subtrees
+    std::deque<solution<dim>> frontier;
+    frontier.emplace_back(ctx);
+    pending = 1;
+    while (!frontier.empty() && frontier.size() < 4 * threads && !done) {
+        const solution<dim> curr = std::move(frontier.front());
+        frontier.pop_front();
+        process(0, curr);
+        --pending;
+        worker& w = *workers[0];
+        while (!w.q.empty()) {
+            frontier.push_back(std::move(w.q.back()));
+            w.q.pop_back();
+        }
+    }
+    for (std::size_t i = 0; i < frontier.size(); ++i)
+        workers[i % threads]->q.push_back(std::move(frontier[i]));
+
+    std::vector<std::thread> pool;
+    for (unsigned int t = 0; t < threads; ++t)
+        pool.emplace_back(&parallel_search::work, this, t);
+    for (auto& t : pool)
+        t.join();
+
+    tot_solutions_generated = 0;
+    for (const auto& w : workers)
+        tot_solutions_generated += w->explored;
+    return best_so_far;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+
+inline unsigned int reduction::core_size() const {
+    unsigned int n = 0;
+    for (const auto& c : nodes)
+        n += static_cast<unsigned int>(c.size());
+    return n;
+}
+
+template<unsigned int dim>
+reduction reduce(const graph<dim>& g, const unsigned int lb) {
+    constexpr unsigned int none = -1;
+    const unsigned int n = g.size();
+    reduction r;
+
+    // degrees within the nodes still alive, which are also kept as a bitset for the dense dominance test
+    std::vector<unsigned int> degree(n);
+    std::vector<bool> alive(n, true);
+    std::vector<uint64_t> alive_bits(g.words(), 0);
+    for (unsigned int i = 0; i < n; ++i) {
+        degree[i] = g.degree(i);
+        set_bit(alive_bits.data(), i);
+    }
+
+    // nodes that may have dropped below lb neighbours
+    std::vector<unsigned int> low;
+    const auto remove = [&](const unsigned int u, const unsigned int by) {
+        alive[u] = false;
+        clear_bit(alive_bits.data(), u);
+        r.removed.emplace_back(u, by);
+        g.for_each_neighbour(u, [&](const unsigned int x) {
+            if (alive[x] && --degree[x] < lb) low.push_back(x);
+        });
+    };
+    const auto peel = [&] {
+        while (!low.empty()) {
+            const unsigned int u = low.back();
+            low.pop_back();
+            if (alive[u] && degree[u] < lb) remove(u, none);
+        }
+    };
+
+    // true if every alive neighbour of u is a neighbour of v
+    const auto covers = [&](const unsigned int v, const unsigned int u) {
+        if (!g.sparse()) {
+            const uint64_t* ru = g.row(u);
+            const uint64_t* rv = g.row(v);
+            for (unsigned int k = 0; k < g.words(); ++k)
+                if (ru[k] & alive_bits[k] & ~rv[k]) return false;
+            return true;
+        }
+        bool all = true;
+        g.for_each_neighbour(u, [&](const unsigned int x) { all = all && (!alive[x] || g(v, x)); });
+        return all;
+    };
+
+    // a node dominating u is adjacent to every alive neighbour of u, in particular to the one of least degree
+    const auto dominator = [&](const unsigned int u) {
+        unsigned int pivot = none;
+        g.for_each_neighbour(u, [&](const unsigned int x) {
+            if (alive[x] && (pivot == none || degree[x] < degree[pivot])) pivot = x;
+        });
+        unsigned int by = none;
+        if (pivot == none) return by;
+        g.for_each_neighbour(pivot, [&](const unsigned int v) {
+            if (by == none && v != u && alive[v] && degree[v] >= degree[u] && !g(u, v) && covers(v, u)) by = v;
+        });
+        return by;
+    };
+
+    for (unsigned int i = 0; i < n; ++i)
+        if (degree[i] < lb) low.push_back(i);
+    peel();
+
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (unsigned int u = 0; u < n; ++u) {
+            if (!alive[u]) continue;
+            if (const unsigned int by = dominator(u); by != none) {
+                remove(u, by);
+                peel();
+                changed = true;
+            }
+        }
+    }
+
+    // connected components of the alive nodes
+    std::vector<bool> seen(n, false);
+    for (unsigned int s = 0; s < n; ++s) {
+        if (!alive[s] || seen[s]) continue;
+        std::vector<unsigned int> component{s};
+        seen[s] = true;
+        for (std::size_t k = 0; k < component.size(); ++k)
+            g.for_each_neighbour(component[k], [&](const unsigned int x) {
+                if (alive[x] && !seen[x]) {
+                    seen[x] = true;
+                    component.push_back(x);
+                }
+            });
+        std::sort(component.begin(), component.end());
+        r.components.emplace_back(g, component);
+        r.nodes.push_back(std::move(component));
+    }
+    return r;
+}
+
+template<unsigned int dim>
+storage_t<unsigned int, dim> restore(const graph<dim>& g, const reduction& r,
+                                     const std::vector<std::vector<unsigned int>>& colorings) {
+    auto color = make_storage<unsigned int, dim>(g.size());
+    for (std::size_t k = 0; k < r.nodes.size(); ++k)
+        for (std::size_t i = 0; i < r.nodes[k].size(); ++i)
+            color[r.nodes[k][i]] = colorings[k][i];
+
+    // every node comes back into the graph it was removed from: a dominated node takes the color of its dominator,
+    // a peeled one the smallest color its neighbours do not use
+    std::vector<bool> used(g.max_degree() + 2, false);
+    for (auto it = r.removed.rbegin(); it != r.removed.rend(); ++it) {
+        const auto [u, by] = *it;
+        if (by != static_cast<unsigned int>(-1)) {
+            color[u] = color[by];
+            continue;
+        }
+        g.for_each_neighbour(u, [&](const unsigned int x) { if (color[x] < used.size()) used[color[x]] = true; });
+        unsigned int c = 1;
+        while (used[c]) ++c;
+        color[u] = c;
+        g.for_each_neighbour(u, [&](const unsigned int x) { if (color[x] < used.size()) used[color[x]] = false; });
+    }
+    return color;
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+inline strategy parse_strategy(const std::string& name) {
+    if (name == "dfs") return strategy::dfs;
+    if (name == "best-first") return strategy::best_first;
+    if (name == "lds") return strategy::lds;
+    if (name == "hybrid") return strategy::hybrid;
+    throw std::runtime_error("Error: Unknown search strategy " + name);
+}
+
+template<unsigned int dim>
+search_state<dim>::search_state(context<dim>& ctx, const solution<dim>* incumbent)
+    : ctx(ctx), colors(ctx.max_colors + 1) {
+    if (incumbent) {
+        best = *incumbent;
+        found = true;
+    }
+}
+
+template<unsigned int dim>
+bool search_state<dim>::optimal() const {
+    return found && ctx.colors_ub <= ctx.colors_lb;
+}
+
+template<unsigned int dim>
+bool search_state<dim>::worth_expanding(const solution<dim>& s) const {
+    return !s.is_final() && s.tot_colors < ctx.colors_ub && (!found || s.bound(ctx) < ctx.colors_ub);
+}
+
+template<unsigned int dim>
+bool search_state<dim>::offer(const solution<dim>& s) {
+    // check if the solution is better than the previous one
+    if (!s.is_final() || (found && s.tot_colors >= ctx.colors_ub)) return false;
+    found = true;
+    ctx.colors_ub = s.tot_colors;
+    best = s;
+    if (ctx.log) *ctx.log << s << std::endl;
+    if (ctx.stats) ctx.stats->improvement(s.tot_colors);
+    return true;
+}
+
+template<unsigned int dim>
+void search_state<dim>::visit(const std::size_t open) {
+    tot_solutions_generated++;
+    if (!ctx.stats) return;
+    search_stats::bump(ctx.stats->slot(0).nodes);
+    ctx.stats->set_depth(0, open);
+}
+
+template<unsigned int dim>
+void search_state<dim>::pruned() {
+    if (ctx.stats) search_stats::bump(ctx.stats->slot(0).prune_bound);
+}
+
+template<unsigned int dim>
+void search_state<dim>::rejected(const unsigned int colors) {
+    if (ctx.stats && colors != 0) search_stats::bump(ctx.stats->slot(0).prune_infeasible, colors);
+}
+
+template<unsigned int dim>
+bool search_state<dim>::out_of_budget() {
+    return ctx.budget && ctx.budget->charge(budget_nodes);
+}
+
+template<unsigned int dim>
+bool search_state<dim>::stopped() const {
+    return ctx.budget && ctx.budget->stopped();
+}
+
+template<unsigned int dim>
+void depth_first(search_state<dim>& state, node_stack<dim>& q) {
+    context<dim>& ctx = state.ctx;
+
+    while (!q.empty() && !state.optimal() && !state.out_of_budget()) {
+        state.visit(q.size());
+
+        // a subtree is expanded only if its lower bound can beat the incumbent
+        if (const solution<dim>& curr = q.top(); state.worth_expanding(curr)) {
+            unsigned int rejected = 0;
+            const unsigned int k = curr.next_colors(ctx, state.colors.data(), &rejected);
+            state.rejected(rejected);
+            if (k == 0) {
+                q.pop();
+                continue;
+            }
+            // add children to the STACK in reverse order, to ensure the first one is popped next. The parent slot
+            // becomes the last child, colored in place
+            q.reserve(k - 1);
+            solution<dim>& parent = q.top();
+            for (unsigned int i = k - 1; i-- > 0;)
+                q.push().assign_child(ctx, parent, state.colors[i]);
+            parent.color_next(ctx, state.colors[k - 1]);
+
+        } else {
+            if (!curr.is_final()) state.pruned();
+            state.offer(curr);
+            q.pop();
+        }
+    }
+}
+
+template<unsigned int dim>
+void best_first(search_state<dim>& state, const std::size_t memory_cap) {
+    context<dim>& ctx = state.ctx;
+
+    struct open_node {
+        unsigned int bound;
+        unsigned int colored;
+        solution<dim> node;
+    };
+    // heap order: lowest bound on top, then the most colored node (closest to a complete solution)
+    const auto later = [](const open_node& a, const open_node& b) {
+        return a.bound != b.bound ? a.bound > b.bound : a.colored < b.colored;
+    };
+    // memory held by an open node, its vectors included
+    const auto node_bytes = [](const solution<dim>& s) {
+        std::size_t bytes = sizeof(open_node);
+        if constexpr (dim == dynamic_dim) bytes += s.color.capacity() * sizeof(color_t<dim>);
+        if constexpr (!single_word_dim<dim>) bytes += s.forbidden.capacity() * sizeof(uint64_t);
+        return bytes;
+    };
+
+    std::vector<open_node> open;
+    std::size_t open_bytes = 0;
+    const auto push = [&](solution<dim>&& s) {
+        open_bytes += node_bytes(s);
+        const unsigned int b = s.bound(ctx);
+        open.push_back(open_node{b, s.colored, std::move(s)});
+        std::push_heap(open.begin(), open.end(), later);
+    };
+
+    // depth-first fallback of the hybrid mode
+    node_stack<dim> q(ctx.g.size() + ctx.max_colors + 1);
+
+    push(solution<dim>(ctx));
+    while (!open.empty() && !state.optimal() && !state.stopped()) {
+        std::pop_heap(open.begin(), open.end(), later);
+        open_node curr = std::move(open.back());
+        open.pop_back();
+        open_bytes -= node_bytes(curr.node);
+
+        // the open node of lowest bound cannot beat the incumbent: no other one can
+        if (state.found && curr.bound >= ctx.colors_ub) break;
+
+        if (memory_cap != 0 && open_bytes + ctx.max_colors * node_bytes(curr.node) > memory_cap &&
+            state.worth_expanding(curr.node)) {
+            // no room for the children: finish the subtree depth-first, it counts its own nodes
+            q.push() = std::move(curr.node);
+            depth_first(state, q);
+            continue;
+        }
+
+        if (state.out_of_budget()) break;
+        state.visit(open.size() + 1);
+        if (!state.worth_expanding(curr.node)) {
+            if (!curr.node.is_final()) state.pruned();
+            state.offer(curr.node);
+            continue;
+        }
+
+        unsigned int rejected = 0;
+        const unsigned int k = curr.node.next_colors(ctx, state.colors.data(), &rejected);
+        state.rejected(rejected);
+        for (unsigned int i = 0; i + 1 < k; ++i) {
+            solution<dim> child;
+            child.assign_child(ctx, curr.node, state.colors[i]);
+            push(std::move(child));
+        }
+        // the parent becomes its last child, colored in place
+        if (k > 0) {
+            curr.node.color_next(ctx, state.colors[k - 1]);
+            push(std::move(curr.node));
+        }
+    }
+}
+
+template<unsigned int dim>
+void limited_discrepancy(search_state<dim>& state) {
+    context<dim>& ctx = state.ctx;
+
+    node_stack<dim> q(ctx.g.size() + ctx.max_colors + 1);
+    // discrepancies spent on the path to each node of q
+    std::vector<unsigned int> spent;
+
+    for (unsigned int limit = 0; !state.optimal() && !state.stopped(); ++limit) {
+        bool cut = false;
+        q.push() = solution<dim>(ctx);
+        spent.assign(1, 0);
+
+        while (!q.empty() && !state.optimal() && !state.out_of_budget()) {
+            state.visit(q.size());
+
+            if (const solution<dim>& curr = q.top(); state.worth_expanding(curr)) {
+                unsigned int rejected = 0;
+                const unsigned int k = curr.next_colors(ctx, state.colors.data(), &rejected);
+                state.rejected(rejected);
+                // every color but the first costs a discrepancy
+                const unsigned int used = spent.back();
+                const unsigned int take = used < limit ? k : std::min(k, 1u);
+                cut = cut || take < k;
+                if (take == 0) {
+                    q.pop();
+                    spent.pop_back();
+                    continue;
+                }
+                // same layout as depth_first: first color on top, the parent slot becomes the last taken color
+                q.reserve(take - 1);
+                solution<dim>& parent = q.top();
+                spent.back() = used + (take > 1);
+                for (unsigned int i = take - 1; i-- > 0;) {
+                    q.push().assign_child(ctx, parent, state.colors[i]);
+                    spent.push_back(used + (i > 0));
+                }
+                parent.color_next(ctx, state.colors[take - 1]);
+
+            } else {
+                if (!curr.is_final()) state.pruned();
+                state.offer(curr);
+                q.pop();
+                spent.pop_back();
+            }
+        }
+
+        // an iteration that never hit the limit has searched the whole tree
+        if (!cut || state.stopped()) break;
+        q.clear();
+    }
+}
+
+template<unsigned int dim>
+solution<dim> sequential_search(context<dim>& ctx, const solution<dim>* incumbent, const strategy order,
+                                const std::size_t memory_cap, unsigned long int& tot_solutions_generated) {
+    search_state<dim> state(ctx, incumbent);
+
+    if (!state.optimal()) {
+        if (order == strategy::best_first || order == strategy::hybrid) {
+            best_first(state, order == strategy::hybrid ? memory_cap : 0);
+        } else if (order == strategy::lds) {
+            limited_discrepancy(state);
+        } else {
+            node_stack<dim> q(ctx.g.size() + ctx.max_colors + 1);
+            q.push() = solution<dim>(ctx);
+            depth_first(state, q);
+        }
+    }
+
+    tot_solutions_generated = state.tot_solutions_generated;
+    return state.best;
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../include/bits.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GC_SIMD_X86 1
+#include <immintrin.h>
+// instruction sets a vector version is compiled for, matching the levels of active_simd()
+#define GC_AVX2 gnu::target("avx2,bmi,popcnt")
+#define GC_AVX512 gnu::target("avx512f,avx512bw,bmi,popcnt")
+#endif
+
+inline const char* simd_name(const simd_level level) {
+    switch (level) {
+    case simd_level::avx2: return "avx2";
+    case simd_level::avx512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+inline simd_level active_simd() {
+    static const simd_level level = [] {
+        simd_level best = simd_level::scalar;
+#ifdef GC_SIMD_X86
+        __builtin_cpu_init();
+        // the vector versions also count and scan bits with the POPCNT and BMI instructions
+        const bool bits = __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("bmi");
+        if (bits && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) best = simd_level::avx512;
+        else if (bits && __builtin_cpu_supports("avx2")) best = simd_level::avx2;
+#endif
+        if (const char* forced = std::getenv("GC_SIMD")) {
+            const std::string name = forced;
+            const simd_level wanted = name == "avx512" ? simd_level::avx512
+                                    : name == "avx2"   ? simd_level::avx2
+                                                       : simd_level::scalar;
+            if (wanted < best) best = wanted;
+        }
+        return best;
+    }();
+    return level;
+}
+
+// scalar versions, also used for the nodes of a partial last block of 64
+
+template<typename C>
+void row_colors_scalar(const uint64_t* row, const unsigned int first_word, const unsigned int words, const C* colors,
+                       uint64_t* set, const unsigned int set_words) {
+    for (unsigned int k = first_word; k < words; ++k)
+        for (uint64_t w = row[k]; w != 0; w &= w - 1) {
+            const unsigned int c = colors[k * 64 + std::countr_zero(w)];
+            if (c != 0 && c < set_words * 64) set_bit(set, c);
+        }
+}
+
+#ifdef GC_SIMD_X86
+
+// the colors of a group of nodes widened to 64-bit lanes: 4 nodes for AVX2, 8 for AVX-512
+template<typename C>
+[[GC_AVX2]] __m256i widen4_avx2(const C* p) {
+    if constexpr (sizeof(C) == 1) {
+        int32_t raw;
+        std::memcpy(&raw, p, sizeof(raw));
+        return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(raw));
+    } else if constexpr (sizeof(C) == 2) {
+        return _mm256_cvtepu16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+    } else {
+        return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    }
+}
+
+// (the lanes out of mask are 0). group is the index of the 8 nodes in their block of 64
+template<typename C>
+[[GC_AVX512]] __m512i widen8_avx512(const C* p, const unsigned int group, const __mmask8 mask) {
+    if constexpr (sizeof(C) == 1) {
+        // 16 bytes inside the block, the group being their low or high half (an 8-byte load here trips GCC 12)
+        const unsigned int half = group & 1;
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - 8 * half));
+        return _mm512_maskz_cvtepu8_epi64(mask, half ? _mm_unpackhi_epi64(chunk, chunk) : chunk);
+    } else if constexpr (sizeof(C) == 2) {
+        return _mm512_maskz_cvtepu16_epi64(mask, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    } else {
+        return _mm512_maskz_cvtepu32_epi64(mask, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+    }
+}
+
+// color sets of up to row_colors_max_words words are built in registers: word o of the set gets 1 << (color - 64 o),
+// the variable shifts leave 0 for the colors outside of it
+constexpr unsigned int row_colors_max_words = 4;
+
+// blocks of 64 nodes with fewer neighbours than this are done bit by bit: one load and one OR per neighbour is hard
+// to beat, the vector version only keeps up on dense blocks
+constexpr int row_colors_min_block = 32;
+
+template<typename C>
+[[GC_AVX2]] void row_colors_avx2(const uint64_t* row, const unsigned int words, const C* colors,
+                                 const unsigned int n, uint64_t* set, const unsigned int set_words) {
+    const unsigned int full = n / 64;
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i lanes = _mm256_setr_epi64x(1, 2, 4, 8);
+    __m256i acc[row_colors_max_words];
+    for (unsigned int o = 0; o < set_words; ++o)
+        acc[o] = _mm256_setzero_si256();
+
+    for (unsigned int k = 0; k < full; ++k) {
+        if (std::popcount(row[k]) < row_colors_min_block) {
+            for (uint64_t w = row[k]; w != 0; w &= w - 1)
+                if (const unsigned int c = colors[k * 64 + std::countr_zero(w)]; c != 0 && c < set_words * 64)
+                    set_bit(set, c);
+            continue;
+        }
+        for (uint64_t w = row[k], g = 0; w != 0; w >>= 4, ++g) {
+            if ((w & 0xf) == 0) continue;
+            // lanes of the nodes of the group that are in the row
+            const __m256i in_row = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(w & 0xf), lanes), lanes);
+            const __m256i c = widen4_avx2(colors + 64 * k + 4 * g);
+            for (unsigned int o = 0; o < set_words; ++o) {
+                const __m256i bit = _mm256_sllv_epi64(one, _mm256_sub_epi64(c, _mm256_set1_epi64x(64 * o)));
+                acc[o] = _mm256_or_si256(acc[o], _mm256_and_si256(bit, in_row));
+            }
+        }
+    }
+    for (unsigned int o = 0; o < set_words; ++o) {
+        alignas(32) uint64_t lane[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane), acc[o]);
+        // bit 0 of word 0 comes from the uncolored nodes
+        set[o] |= (lane[0] | lane[1] | lane[2] | lane[3]) & (o == 0 ? ~uint64_t{1} : ~uint64_t{0});
+    }
+    row_colors_scalar(row, full, words, colors, set, set_words);
+}
+
+template<typename C>
+[[GC_AVX512]] void row_colors_avx512(const uint64_t* row, const unsigned int words, const C* colors,
+                                     const unsigned int n, uint64_t* set, const unsigned int set_words) {
+    const unsigned int full = n / 64;
+    const __m512i one = _mm512_set1_epi64(1);
+    __m512i acc[row_colors_max_words];
+    for (unsigned int o = 0; o < set_words; ++o)
+        acc[o] = _mm512_setzero_si512();
+
+    for (unsigned int k = 0; k < full; ++k) {
+        if (std::popcount(row[k]) < row_colors_min_block) {
+            for (uint64_t w = row[k]; w != 0; w &= w - 1)
+                if (const unsigned int c = colors[k * 64 + std::countr_zero(w)]; c != 0 && c < set_words * 64)
+                    set_bit(set, c);
+            continue;
+        }
+        for (uint64_t w = row[k], g = 0; w != 0; w >>= 8, ++g) {
+            const auto in_row = static_cast<__mmask8>(w & 0xff);
+            if (in_row == 0) continue;
+            const __m512i c = widen8_avx512(colors + 64 * k + 8 * g, static_cast<unsigned int>(g), in_row);
+            for (unsigned int o = 0; o < set_words; ++o) {
+                const __m512i shift = _mm512_sub_epi64(c, _mm512_set1_epi64(64 * o));
+                acc[o] = _mm512_or_si512(acc[o], _mm512_maskz_sllv_epi64(in_row, one, shift));
+            }
+        }
+    }
+    for (unsigned int o = 0; o < set_words; ++o) {
+        alignas(64) uint64_t lane[8];
+        _mm512_store_si512(lane, acc[o]);
+        uint64_t bits = 0;
+        for (const uint64_t l : lane)
+            bits |= l;
+        set[o] |= bits & (o == 0 ? ~uint64_t{1} : ~uint64_t{0});
+    }
+    row_colors_scalar(row, full, words, colors, set, set_words);
+}
+
+[[GC_AVX2]] inline unsigned int row_saturate_avx2(const uint64_t* row, uint64_t* seen, const uint64_t* open,
+                                                  uint64_t* fresh, const unsigned int words) {
+    unsigned int count = 0, k = 0;
+    for (; k + 4 <= words; k += 4) {
+        const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + k));
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(seen + k));
+        const __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(open + k));
+        const __m256i f = _mm256_and_si256(_mm256_andnot_si256(s, r), o);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(fresh + k), f);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(seen + k), _mm256_or_si256(s, r));
+        for (unsigned int q = 0; q < 4; ++q)
+            count += std::popcount(fresh[k + q]);
+    }
+    for (; k < words; ++k) {
+        fresh[k] = row[k] & ~seen[k] & open[k];
+        seen[k] |= row[k];
+        count += std::popcount(fresh[k]);
+    }
+    return count;
+}
+
+[[GC_AVX512]] inline unsigned int row_saturate_avx512(const uint64_t* row, uint64_t* seen, const uint64_t* open,
+                                                      uint64_t* fresh, const unsigned int words) {
+    unsigned int count = 0, k = 0;
+    for (; k + 8 <= words; k += 8) {
+        const __m512i r = _mm512_loadu_si512(row + k);
+        const __m512i s = _mm512_loadu_si512(seen + k);
+        // ~s & r & open in one instruction
+        const __m512i f = _mm512_ternarylogic_epi64(s, r, _mm512_loadu_si512(open + k), 0x08);
+        _mm512_storeu_si512(fresh + k, f);
+        _mm512_storeu_si512(seen + k, _mm512_or_si512(s, r));
+        for (unsigned int q = 0; q < 8; ++q)
+            count += std::popcount(fresh[k + q]);
+    }
+    for (; k < words; ++k) {
+        fresh[k] = row[k] & ~seen[k] & open[k];
+        seen[k] |= row[k];
+        count += std::popcount(fresh[k]);
+    }
+    return count;
+}
+
+#endif // GC_SIMD_X86
+
+template<typename C>
+void row_colors(const uint64_t* row, const unsigned int words, const C* colors, const unsigned int n, uint64_t* set,
+                const unsigned int set_words) {
+#ifdef GC_SIMD_X86
+    if (set_words <= row_colors_max_words) {
+        switch (active_simd()) {
+        case simd_level::avx512: return row_colors_avx512(row, words, colors, n, set, set_words);
+        case simd_level::avx2: return row_colors_avx2(row, words, colors, n, set, set_words);
+        default: break;
+        }
+    }
+#else
+    (void) n;
+#endif
+    row_colors_scalar(row, 0, words, colors, set, set_words);
+}
+
+inline unsigned int row_saturate(const uint64_t* row, uint64_t* seen, const uint64_t* open, uint64_t* fresh,
+                                 const unsigned int words) {
+#ifdef GC_SIMD_X86
+    switch (active_simd()) {
+    case simd_level::avx512: return row_saturate_avx512(row, seen, open, fresh, words);
+    case simd_level::avx2: return row_saturate_avx2(row, seen, open, fresh, words);
+    default: break;
+    }
+#endif
+    unsigned int count = 0;
+    for (unsigned int k = 0; k < words; ++k) {
+        fresh[k] = row[k] & ~seen[k] & open[k];
+        seen[k] |= row[k];
+        count += std::popcount(fresh[k]);
+    }
+    return count;
+}
+
+template<unsigned int n, typename C>
+uint64_t color_mask(const C* colors, const C c) {
+    static_assert(n <= 64, "A color mask holds at most 64 nodes");
+    uint64_t mask = 0;
+    if constexpr (sizeof(C) == 1) {
+        constexpr uint64_t low = 0x7f7f7f7f7f7f7f7full;
+        const uint64_t pattern = uint64_t{c} * 0x0101010101010101ull;
+        for (unsigned int k = 0; k < n; k += 8) {
+            uint64_t x = 0;
+            std::memcpy(&x, colors + k, std::min(8u, n - k));
+            x ^= pattern;
+            // 0x80 in the bytes equal to c, whose top bits the multiplication gathers into the 8 high bits
+            const uint64_t equal = ~(((x & low) + low) | x | low);
+            mask |= ((equal >> 7) * 0x0102040810204080ull >> 56) << k;
+        }
+        // the bytes past n were zero before the xor
+        if constexpr (n % 64 != 0) mask &= (uint64_t{1} << n) - 1;
+    } else {
+        for (unsigned int i = 0; i < n; ++i)
+            mask |= uint64_t{colors[i] == c} << i;
+    }
+    return mask;
+}
@@ -1,66 +1,233 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
+
+#include "../include/simd.h"
+
+template<unsigned int dim>
+solution<dim>::solution() : color{}, forbidden{}, tot_colors(0), colored(0), next(0) {}
+
+template<unsigned int dim>
+solution<dim>::solution(const context<dim>& ctx)
+    : solution(ctx, make_storage<unsigned int, dim>(ctx.g.size())) {
+    // symmetry breaking: the root clique starts with colors 1, 2, ...
+    for (unsigned int k = 0; k < ctx.root_clique.size(); ++k)
+        paint(ctx, ctx.root_clique[k], k + 1);
+    next = select_next(ctx, size());
+}
+
+template<unsigned int dim>
+solution<dim>::solution(const context<dim>& ctx, const storage_t<unsigned int, dim>& coloring)
+    : color{}, forbidden{}, tot_colors(0), colored(0), next(0) {
+    if constexpr (dim == dynamic_dim) {
+        if (ctx.max_colors > std::numeric_limits<color_t<dim>>::max()) {
+            throw std::runtime_error("Error: Too many colors for a dynamic_dim solution");
+        }
+        color.assign(ctx.g.size(), 0);
+    }
+    if constexpr (!single_word_dim<dim>) {
+        cw = ctx.color_words();
+        forbidden.assign(static_cast<std::size_t>(size()) * color_words(), 0);
+    }
+    if (ctx.g.sparse()) {
+        for (unsigned int i = 0; i < size(); ++i)
+            if (coloring[i] != 0) paint(ctx, i, coloring[i]);
+        next = select_next(ctx, size());
+        return;
+    }
+
+    for (unsigned int i = 0; i < size(); ++i) {
+        if (coloring[i] == 0) continue;
+        color[i] = static_cast<color_t<dim>>(coloring[i]);
+        tot_colors = std::max(tot_colors, coloring[i]);
+        ++colored;
+    }
+    if constexpr (single_word_dim<dim>) {
+        // the nodes that cannot take a color are the neighbours of the nodes that have it
+        for (unsigned int i = 0; i < size(); ++i)
+            if (color[i] != 0) forbidden[color[i]] |= ctx.g.row(i)[0];
+    } else if (colored != 0) {
+        // the forbidden colors of a node are the colors of its row, gathered a block of nodes at a time
+        const unsigned int words = color_words();
+        for (unsigned int i = 0; i < size(); ++i)
+            row_colors(ctx.g.row(i), ctx.g.words(), color.data(), size(), forbidden.data() + std::size_t{i} * words,
+                       words);
+    }
+    next = select_next(ctx, size());
+}
+
+template<unsigned int dim>
+void solution<dim>::paint(const context<dim>& ctx, const unsigned int node, const unsigned int node_color) {
+    color[node] = static_cast<color_t<dim>>(node_color);
+    tot_colors = std::max(tot_colors, node_color);
+    ++colored;
+
+    // the color is now forbidden for all the neighbours of the node
+    if constexpr (single_word_dim<dim>) {
+        forbidden[node_color] |= ctx.g.row(node)[0];
+        return;
+    }
+    const unsigned int words = color_words();
+    ctx.g.for_each_neighbour(node, [&](const unsigned int j) {
+        set_bit(forbidden.data() + static_cast<std::size_t>(j) * words, node_color);
+    });
+}
+
+template<unsigned int dim>
+unsigned int solution<dim>::size() const {
+    return static_cast<unsigned int>(color.size());
+}
 
 template<unsigned int dim>
-unsigned int solution<dim>::colors_ub = dim;
+storage_t<unsigned int, dim> solution<dim>::coloring() const {
+    auto c = make_storage<unsigned int, dim>(size());
+    std::copy(std::begin(color), std::end(color), std::begin(c));
+    return c;
+}
 
 template<unsigned int dim>
-graph<dim>* solution<dim>::g = nullptr;
+unsigned int solution<dim>::color_words() const {
+    if constexpr (single_word_dim<dim>) return bit_words(dim + 1);
+    else return cw;
+}
 
 template<unsigned int dim>
-solution<dim>::solution() : color{}, tot_colors(0), next(0) {}
+const uint64_t* solution<dim>::forbidden_colors(const unsigned int i) const {
+    return forbidden.data() + static_cast<std::size_t>(i) * color_words();
+}
+
+template<unsigned int dim>
+unsigned int solution<dim>::saturation(const unsigned int i) const {
+    if constexpr (single_word_dim<dim>) {
+        // only the colors used so far can be forbidden
+        unsigned int s = 0;
+        for (unsigned int c = 1; c <= tot_colors; ++c)
+            s += (forbidden[c] >> i) & 1;
+        return s;
+    }
+    return count_bits(forbidden_colors(i), color_words());
+}
 
 template<unsigned int dim>
 bool solution<dim>::is_final() const {
-    for (unsigned int i = 0; i < dim; ++i)
-        if (color[i] == 0) return false;
-    return true;
+    return colored == size();
 }
 
 template<unsigned int dim>
-std::vector<solution<dim>> solution<dim>::get_next() const {
+unsigned int solution<dim>::bound(const context<dim>& ctx) const {
+    unsigned int b = tot_colors;
+    if (!is_final() && saturation(next) >= tot_colors) ++b;
+    return std::max(b, ctx.colors_lb);
+}
+
+template<unsigned int dim>
+unsigned int solution<dim>::next_colors(const context<dim>& ctx, unsigned int* out, unsigned int* rejected) const {
     assert(this->is_final() == false && "Cannot generate children of a complete solution!");
 
     const unsigned int node_to_color = this->next;
-    const unsigned int colors = tot_colors + 1;
+    // a child may open at most one new color, and must not use more than the current known upper bound
+    const unsigned int colors =
+        std::min({tot_colors + 1, ctx.colors_ub.load(std::memory_order_relaxed), ctx.max_colors});
     //const unsigned int colors = dim;
 
-    std::vector<solution<dim>> children;
-    children.reserve(colors);
-
-    for (unsigned int i = 1; i <= colors; ++i) {
-        // generate a child node and check if the color assignment is valid. If it is, add it to the list only if the
-        // total number of colors used id no more than the current known upper bound.
-        if (const solution child = solution(*this, node_to_color, i);
-            child.is_valid(node_to_color) && child.tot_colors <= colors_ub) {
-            children.emplace_back(child);
-        }
+    // a colored dominator leaves a single color worth trying
+    if (const unsigned int c = ctx.forced_color(node_to_color, [&](const unsigned int i) { return color[i]; });
+        c != 0) {
+        if (rejected) *rejected = 0;
+        if (c > colors) return 0;
+        out[0] = c;
+        return 1;
     }
 
+    // enumerate the feasible colors straight from the forbidden set of the node: no validity check is needed
+    unsigned int count = 0;
+    if constexpr (single_word_dim<dim>) {
+        for (unsigned int c = 1; c <= colors; ++c)
+            if (((forbidden[c] >> node_to_color) & 1) == 0) out[count++] = c;
+        if (rejected) *rejected = colors - count;
+        return count;
+    }
+    const uint64_t* mask = forbidden_colors(node_to_color);
+    for (unsigned int k = 0; k <= colors / 64; ++k) {
+        uint64_t feasible = ~mask[k];
+        if (k == 0) feasible &= ~uint64_t{1};                                  // colors start from 1
+        if (k == colors / 64) feasible &= (uint64_t{2} << (colors % 64)) - 1;  // and stop at colors
+        for (; feasible != 0; feasible &= feasible - 1)
+            out[count++] = k * 64 + std::countr_zero(feasible);
+    }
+    if (rejected) *rejected = colors - count;
+    return count;
+}
+
+template<unsigned int dim>
+std::vector<solution<dim>> solution<dim>::get_next(const context<dim>& ctx, unsigned int* rejected) const {
+    std::vector<unsigned int> colors(ctx.max_colors + 1);
+    colors.resize(next_colors(ctx, colors.data(), rejected));
+
+    std::vector<solution<dim>> children;
+    children.reserve(colors.size());
+    for (const unsigned int c : colors) {
+        children.emplace_back(solution(ctx, *this, next, c));
+        assert(children.back().is_valid(ctx, next));
+    }
     return children;
 }
 
 template<unsigned int dim>
-solution<dim>::solution(const solution<dim>& parent, unsigned int node_to_color, unsigned int node_color) {
-    // copy the color assignment from the parent solution
-    std::copy(std::begin(parent.color), std::end(parent.color), std::begin(this->color));
+void solution<dim>::assign_child(const context<dim>& ctx, const solution<dim>& parent, const unsigned int c) {
+    // copy assignments: the storage of this is reused, no allocation once it has the size of parent
+    color = parent.color;
+    forbidden = parent.forbidden;
+    cw = parent.cw;
+    tot_colors = parent.tot_colors;
+    colored = parent.colored;
+    next = parent.next;
+    color_next(ctx, c);
+}
 
-    // copy parameters
-    tot_colors = node_color > parent.tot_colors ? parent.tot_colors + 1 : parent.tot_colors;
-    next = node_to_color + 1 >= dim ? -1 : node_to_color + 1;
+template<unsigned int dim>
+void solution<dim>::color_next(const context<dim>& ctx, const unsigned int c) {
+    const unsigned int node_to_color = next;
+    paint(ctx, node_to_color, c);
+    assert(is_valid(ctx, node_to_color));
+    next = select_next(ctx, node_to_color);
+}
+
+template<unsigned int dim>
+solution<dim>::solution(const context<dim>& ctx, const solution<dim>& parent, unsigned int node_to_color,
+                        unsigned int node_color)
+    // copy the color assignment and forbidden colors from the parent solution
+    : color(parent.color), forbidden(parent.forbidden), tot_colors(parent.tot_colors), colored(parent.colored),
+      cw(parent.cw) {
 
     // color the node
-    color[node_to_color] = node_color;
+    paint(ctx, node_to_color, node_color);
+
+    next = select_next(ctx, node_to_color);
 }
 
 template<unsigned int dim>
-bool solution<dim>::is_valid(const unsigned int node_to_check) const {
-    const unsigned int i = node_to_check;
-    for (unsigned int j = 0; j < dim; ++j)
-        // if two nodes are adjacent and are colored the same the solution is not valid.
-        if (g->operator()(i, j) == true && color[i] == color[j]) return false;
-
+unsigned int solution<dim>::select_next(const context<dim>& ctx, const unsigned int last) const {
+    if constexpr (single_word_dim<dim>) {
+        // the uncolored nodes are the colors equal to 0, found without a loop over the nodes
+        const unsigned int node = ctx.next_open_node(last, color_mask<dim>(color.data(), color_t<dim>{0}),
+            [&](const unsigned int i) { return saturation(i); });
+        return node >= size() ? -1 : node;
+    }
+    const unsigned int node = ctx.next_node(last,
+        [&](const unsigned int i) { return color[i]; },
+        [&](const unsigned int i) { return saturation(i); });
+    return node >= size() ? -1 : node;
+}
 
-    return true;
+template<unsigned int dim>
+bool solution<dim>::is_valid(const context<dim>& ctx, const unsigned int node_to_check) const {
+    const unsigned int i = node_to_check;
+    // if two nodes are adjacent and are colored the same the solution is not valid.
+    if constexpr (single_word_dim<dim>) return (ctx.g.row(i)[0] & color_mask<dim>(color.data(), color[i])) == 0;
+    bool valid = true;
+    ctx.g.for_each_neighbour(i, [&](const unsigned int j) { valid = valid && color[i] != color[j]; });
+    return valid;
 }
\ No newline at end of file
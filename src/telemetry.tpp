@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+inline search_stats::search_stats(const unsigned int threads) : threads(std::max(threads, 1u)) {}
+
+inline search_stats::counters& search_stats::slot(const unsigned int id) {
+    return threads[id % threads.size()];
+}
+
+inline void search_stats::bump(std::atomic<uint64_t>& c, const uint64_t n) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void search_stats::set_depth(const unsigned int id, const uint64_t depth) {
+    counters& c = slot(id);
+    c.depth.store(depth, std::memory_order_relaxed);
+    if (depth > c.peak_depth.load(std::memory_order_relaxed)) c.peak_depth.store(depth, std::memory_order_relaxed);
+}
+
+inline void search_stats::improvement(const unsigned int colors) {
+    std::lock_guard lock(improvements_mutex);
+    improvements.emplace_back(elapsed(), colors);
+}
+
+inline double search_stats::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline stats_reporter::stats_reporter(const search_stats& stats, const double period_s, const std::string& json_path)
+    : stats(stats), period_s(period_s), json_path(json_path) {
+    if (!json_path.empty()) {
+        // start from an empty file, every snapshot is appended
+        std::ofstream file(json_path, std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Error: Unable to write file " + json_path);
+        }
+    }
+    reporter = std::thread([this] {
+        std::unique_lock lock(m);
+        while (!cv.wait_for(lock, std::chrono::duration<double>(this->period_s), [this] { return stop; })) {
+            lock.unlock();
+            report();
+            lock.lock();
+        }
+    });
+}
+
+inline stats_reporter::~stats_reporter() {
+    {
+        std::lock_guard lock(m);
+        stop = true;
+    }
+    cv.notify_one();
+    reporter.join();
+    report();
+}
+
+inline void stats_reporter::report() {
+    const double now = stats.elapsed();
+
+    uint64_t nodes = 0, depth = 0, peak = 0, prune_bound = 0, prune_infeasible = 0;
+    for (const auto& c : stats.threads) {
+        nodes += c.nodes.load(std::memory_order_relaxed);
+        depth = std::max(depth, c.depth.load(std::memory_order_relaxed));
+        peak = std::max(peak, c.peak_depth.load(std::memory_order_relaxed));
+        prune_bound += c.prune_bound.load(std::memory_order_relaxed);
+        prune_infeasible += c.prune_infeasible.load(std::memory_order_relaxed);
+    }
+    const double rate = now > last_time ? static_cast<double>(nodes - last_nodes) / (now - last_time) : 0.0;
+    last_nodes = nodes;
+    last_time = now;
+
+    std::vector<std::pair<double, unsigned int>> improvements;
+    {
+        std::lock_guard lock(stats.improvements_mutex);
+        improvements = stats.improvements;
+    }
+
+    std::ostringstream out;
+    if (json_path.empty()) {
+        out << "[stats] " << now << "s nodes " << nodes << " (" << static_cast<uint64_t>(rate) << "/s) depth "
+            << depth << " (peak " << peak << ") prunes bound " << prune_bound << " infeasible " << prune_infeasible;
+        if (!improvements.empty())
+            out << " best " << improvements.back().second << " at " << improvements.back().first << "s";
+        out << "\n";
+        if (stats.threads.size() > 1) {
+            for (std::size_t t = 0; t < stats.threads.size(); ++t) {
+                const auto& c = stats.threads[t];
+                out << "[stats]   thread " << t << " nodes " << c.nodes.load(std::memory_order_relaxed) << " depth "
+                    << c.depth.load(std::memory_order_relaxed) << " (peak "
+                    << c.peak_depth.load(std::memory_order_relaxed) << ")\n";
+            }
+        }
+        std::cerr << out.str() << std::flush;
+        return;
+    }
+
+    out << "{\"time\": " << now << ", \"nodes\": " << nodes << ", \"nodes_per_s\": " << rate << ", \"depth\": "
+        << depth << ", \"peak_depth\": " << peak << ", \"prunes\": {\"bound\": " << prune_bound
+        << ", \"infeasible\": " << prune_infeasible << "}, \"improvements\": [";
+    for (std::size_t k = 0; k < improvements.size(); ++k)
+        out << (k ? ", " : "") << "{\"time\": " << improvements[k].first << ", \"colors\": " << improvements[k].second
+            << "}";
+    out << "], \"threads\": [";
+    for (std::size_t t = 0; t < stats.threads.size(); ++t) {
+        const auto& c = stats.threads[t];
+        out << (t ? ", " : "") << "{\"nodes\": " << c.nodes.load(std::memory_order_relaxed) << ", \"depth\": "
+            << c.depth.load(std::memory_order_relaxed) << ", \"peak_depth\": "
+            << c.peak_depth.load(std::memory_order_relaxed) << ", \"prune_bound\": "
+            << c.prune_bound.load(std::memory_order_relaxed) << ", \"prune_infeasible\": "
+            << c.prune_infeasible.load(std::memory_order_relaxed) << "}";
+    }
+    out << "]}\n";
+
+    std::ofstream file(json_path, std::ios::app);
+    file << out.str();
+}